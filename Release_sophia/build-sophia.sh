@@ -21,13 +21,45 @@ if [[ "${STATIC:-false}" == "true" ]]; then
 fi
 
 $CPP $CPP_OPTS -o "Alignment.o" "../src/Alignment.cpp"
+$CPP $CPP_OPTS -o "BamIndex.o" "../src/BamIndex.cpp"
+$CPP $CPP_OPTS -o "BamReader.o" "../src/BamReader.cpp"
+$CPP $CPP_OPTS -o "BedReader.o" "../src/BedReader.cpp"
+$CPP $CPP_OPTS -o "BgzfReader.o" "../src/BgzfReader.cpp"
+$CPP $CPP_OPTS -o "BgzfWriter.o" "../src/BgzfWriter.cpp"
 $CPP $CPP_OPTS -o "Breakpoint.o" "../src/Breakpoint.cpp"
+$CPP $CPP_OPTS -o "BreakpointFinalizer.o" "../src/BreakpointFinalizer.cpp"
+$CPP $CPP_OPTS -o "BreakpointOutput.o" "../src/BreakpointOutput.cpp"
+$CPP $CPP_OPTS -o "BreakpointWindow.o" "../src/BreakpointWindow.cpp"
+$CPP $CPP_OPTS -o "Checkpoint.o" "../src/Checkpoint.cpp"
 $CPP $CPP_OPTS -o "ChosenBp.o" "../src/ChosenBp.cpp"
 $CPP $CPP_OPTS -o "ChrConverter.o" "../src/ChrConverter.cpp"
+$CPP $CPP_OPTS -o "CompactAlignment.o" "../src/CompactAlignment.cpp"
+$CPP $CPP_OPTS -o "CoverageWindow.o" "../src/CoverageWindow.cpp"
+$CPP $CPP_OPTS -o "CramCodecs.o" "../src/CramCodecs.cpp"
+$CPP $CPP_OPTS -o "CramReader.o" "../src/CramReader.cpp"
+$CPP $CPP_OPTS -o "DepthTrack.o" "../src/DepthTrack.cpp"
+$CPP $CPP_OPTS -o "IndexedBamMapper.o" "../src/IndexedBamMapper.cpp"
+$CPP $CPP_OPTS -o "Md5.o" "../src/Md5.cpp"
+$CPP $CPP_OPTS -o "MergedRecordReader.o" "../src/MergedRecordReader.cpp"
+$CPP $CPP_OPTS -o "PackedOverhang.o" "../src/PackedOverhang.cpp"
+$CPP $CPP_OPTS -o "PairedSampleMapper.o" "../src/PairedSampleMapper.cpp"
+$CPP $CPP_OPTS -o "QualityHistogram.o" "../src/QualityHistogram.cpp"
+$CPP $CPP_OPTS -o "ReadBatch.o" "../src/ReadBatch.cpp"
+$CPP $CPP_OPTS -o "ReadBatchPipeline.o" "../src/ReadBatchPipeline.cpp"
+$CPP $CPP_OPTS -o "ReadCalibrator.o" "../src/ReadCalibrator.cpp"
+$CPP $CPP_OPTS -o "ReadFilter.o" "../src/ReadFilter.cpp"
+$CPP $CPP_OPTS -o "RecordReader.o" "../src/RecordReader.cpp"
+$CPP $CPP_OPTS -o "ReferenceFasta.o" "../src/ReferenceFasta.cpp"
+$CPP $CPP_OPTS -o "RegionBitmap.o" "../src/RegionBitmap.cpp"
+$CPP $CPP_OPTS -o "ReplayRecordReader.o" "../src/ReplayRecordReader.cpp"
+$CPP $CPP_OPTS -o "SaTag.o" "../src/SaTag.cpp"
+$CPP $CPP_OPTS -o "SamLineReader.o" "../src/SamLineReader.cpp"
 $CPP $CPP_OPTS -o "SamSegmentMapper.o" "../src/SamSegmentMapper.cpp"
+$CPP $CPP_OPTS -o "SamTokenizer.o" "../src/SamTokenizer.cpp"
 $CPP $CPP_OPTS -o "Sdust.o" "../src/Sdust.cpp"
 $CPP $CPP_OPTS -o "SuppAlignment.o" "../src/SuppAlignment.cpp"
+$CPP $CPP_OPTS -o "WindowBudget.o" "../src/WindowBudget.cpp"
 $CPP $CPP_OPTS -o "HelperFunctions.o" "../src/HelperFunctions.cpp"
 $CPP $CPP_OPTS -o "sophia.o" "../sophia.cpp"
 
-$CPP -L$CONDA_PREFIX/lib -flto -o "sophia"  Alignment.o Breakpoint.o ChosenBp.o ChrConverter.o SamSegmentMapper.o Sdust.o SuppAlignment.o HelperFunctions.o sophia.o -lboost_program_options
+$CPP -L$CONDA_PREFIX/lib -flto -o "sophia"  Alignment.o BamIndex.o BamReader.o BedReader.o BgzfReader.o BgzfWriter.o Breakpoint.o BreakpointFinalizer.o BreakpointOutput.o BreakpointWindow.o Checkpoint.o ChosenBp.o ChrConverter.o CompactAlignment.o CoverageWindow.o CramCodecs.o CramReader.o DepthTrack.o IndexedBamMapper.o Md5.o MergedRecordReader.o PackedOverhang.o PairedSampleMapper.o QualityHistogram.o ReadBatch.o ReadBatchPipeline.o ReadCalibrator.o ReadFilter.o RecordReader.o ReferenceFasta.o RegionBitmap.o ReplayRecordReader.o SaTag.o SamLineReader.o SamSegmentMapper.o SamTokenizer.o Sdust.o SuppAlignment.o WindowBudget.o HelperFunctions.o sophia.o -lboost_program_options -lz -pthread
@@ -0,0 +1,176 @@
+/*
+ * CoverageFrontierBenchmark.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+// Runs SamSegmentMapper over a synthetic dense clip pileup, the way sophia
+// maps SAM input on a single thread. Every read has a clip at either end and
+// a read starts every 1.5 bases, and a breakpoint stays open for 2.51 times
+// the default read length the mapper is given. Raising that length widens
+// the window, so the number of open breakpoints grows into the thousands
+// while the reads stay the same. printBps sets the coverages from the
+// coverage frontier, so the time per read must not grow with the open
+// breakpoints. Build from this directory with
+//
+//   g++ -std=c++1z -O3 -I../include -o CoverageFrontierBenchmark
+//       CoverageFrontierBenchmark.cpp
+//       $(grep -o '\.\./src/[A-Za-z]*\.cpp' ../Release_sophia/build-sophia.sh)
+//       -lz -pthread
+//
+// and once more with -DSOPHIA_COVERAGE_FULL_SCAN for the baseline, which
+// scans every open breakpoint for each read as printBps used to. The window
+// lengths to run can be given as arguments.
+
+#include "BreakpointOutput.h"
+#include "ReadFilter.h"
+#include "ReadParameters.h"
+#include "SamLineReader.h"
+#include "SamSegmentMapper.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sophia;
+
+namespace {
+
+const int ALIGNMENTS = 200000;
+const int ROUNDS = 3;
+const int READLENGTH = 101;
+const int CLIPLENGTH = 20;
+
+// a sorted pileup of proper pairs on chromosome 1 with a soft clip at either
+// end of every read, the clip positions go to clipPositions
+FILE *
+generateSam(vector<pair<int, int>> &clipPositions) {
+    mt19937 random{20261017};
+    auto *sam = tmpfile();
+    if (sam == nullptr) {
+        perror("Error creating the SAM file");
+        exit(1);
+    }
+    const string bases{"ACGT"};
+    const string qualities(READLENGTH, 'I');
+    const auto cigar = to_string(CLIPLENGTH) + "S" +
+                       to_string(READLENGTH - 2 * CLIPLENGTH) + "M" +
+                       to_string(CLIPLENGTH) + "S";
+    auto position = 10000;
+    for (auto i = 0; i < ALIGNMENTS; ++i) {
+        position += random() % 4;
+        string sequence(READLENGTH, 'A');
+        for (auto j = 0; j < READLENGTH; ++j) {
+            sequence[j] = bases[random() % 4];
+        }
+        fprintf(sam, "r%d\t99\t1\t%d\t60\t%s\t=\t%d\t350\t%s\t%s\n", i,
+                position, cigar.c_str(), position + 250, sequence.c_str(),
+                qualities.c_str());
+        clipPositions.emplace_back(
+            position - 1, position - 1 + READLENGTH - 2 * CLIPLENGTH);
+    }
+    return sam;
+}
+
+// the mean number of breakpoints open when a read arrives, with breakpoints
+// dropped once they are rightRange left of the read start as in printBps
+double
+meanOpenBreakpoints(const vector<pair<int, int>> &clipPositions,
+                    int rightRange) {
+    set<int> open;
+    auto total = 0.0;
+    for (const auto &clips : clipPositions) {
+        auto start = clips.first;
+        open.erase(open.begin(), open.lower_bound(start - rightRange));
+        total += open.size();
+        open.insert(clips.first);
+        open.insert(clips.second);
+    }
+    return total / clipPositions.size();
+}
+
+struct Result {
+    size_t reportBytes;
+    double seconds;
+};
+
+Result
+run(FILE *sam, int windowReadLength) {
+    Result result{0, 1e30};
+    for (auto round = 0; round < ROUNDS; ++round) {
+        rewind(sam);
+        ostringstream reports;
+        BreakpointOutput output{false, reports};
+        ReadParameters readParameters{windowReadLength, 2000.0};
+        SamSegmentMapper mapper{readParameters, 1, output, nullptr, nullptr,
+                                nullptr};
+        SamLineReader lineReader{sam};
+        ReadFilter readFilter{};
+        auto start = chrono::steady_clock::now();
+        mapper.parseSamStream(lineReader, readFilter);
+        auto seconds = chrono::duration<double>(
+                           chrono::steady_clock::now() - start)
+                           .count();
+        if (seconds < result.seconds) {
+            result = Result{reports.str().size(), seconds};
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+int
+main(int argc, char **argv) {
+    vector<int> windowReadLengths{101, 400, 1000, 2500, 5000};
+    if (argc > 1) {
+        windowReadLengths.clear();
+        for (auto i = 1; i < argc; ++i) {
+            windowReadLengths.push_back(stoi(argv[i]));
+        }
+    }
+#ifdef SOPHIA_COVERAGE_FULL_SCAN
+    const string scan{"full scan"};
+#else
+    const string scan{"frontier"};
+#endif
+    vector<pair<int, int>> clipPositions;
+    auto *sam = generateSam(clipPositions);
+    cout << ALIGNMENTS << " reads of " << READLENGTH << " bp, " << scan
+         << endl;
+    cout << right << setw(14) << "window length" << setw(14) << "open bps"
+         << setw(14) << "ns/read" << setw(14) << "report bytes" << endl;
+    for (auto windowReadLength : windowReadLengths) {
+        auto rightRange = static_cast<int>(round(windowReadLength * 2.51));
+        auto result = run(sam, windowReadLength);
+        cout << setw(14) << windowReadLength << fixed << setprecision(0)
+             << setw(14) << meanOpenBreakpoints(clipPositions, rightRange)
+             << setprecision(1) << setw(14)
+             << result.seconds * 1e9 / ALIGNMENTS << setw(14)
+             << result.reportBytes << endl;
+    }
+    fclose(sam);
+    return 0;
+}
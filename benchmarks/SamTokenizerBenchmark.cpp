@@ -0,0 +1,207 @@
+/*
+ * SamTokenizerBenchmark.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+// Compares the SamTokenizer scanners with the byte loop the Alignment
+// constructor used to record every tab of a line. The lines are read from a
+// SAM file given as the only argument, or generated as 150 bp BWA-MEM records
+// with NM, MD, AS, XS, RG and XA tags. Build from this directory with the
+// single command
+//
+//   g++ -std=c++1z -O3 -I../include -o SamTokenizerBenchmark
+//       SamTokenizerBenchmark.cpp ../src/SamTokenizer.cpp
+
+#include "SamTokenizer.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+using namespace std;
+using namespace sophia;
+
+namespace {
+
+const int FIELDTABS = 11;
+const int ROUNDS = 5;
+
+vector<string>
+generateLines(int count) {
+    mt19937 random{20261017};
+    const string bases{"ACGT"};
+    auto randomBases = [&](int length) {
+        string sequence;
+        for (auto i = 0; i < length; ++i) {
+            sequence.push_back(bases[random() % 4]);
+        }
+        return sequence;
+    };
+    vector<string> lines;
+    auto position = 10000;
+    for (auto i = 0; i < count; ++i) {
+        position += random() % 20;
+        string quality;
+        for (auto j = 0; j < 150; ++j) {
+            quality.push_back(static_cast<char>('#' + random() % 40));
+        }
+        auto tlen = 250 + static_cast<int>(random() % 200);
+        string line = "HWI-ST1234:8:1101:" + to_string(random() % 20000) +
+                      ":" + to_string(random() % 200000) + "\t99\t1\t" +
+                      to_string(position) + "\t60\t150M\t=\t" +
+                      to_string(position + tlen - 150) + "\t" +
+                      to_string(tlen) + "\t" + randomBases(150) + "\t" +
+                      quality;
+        auto mismatch = 10 + random() % 120;
+        line += "\tNM:i:1\tMD:Z:" + to_string(mismatch) + randomBases(1) +
+                to_string(149 - mismatch) + "\tAS:i:145\tXS:i:" +
+                to_string(100 + random() % 40) +
+                "\tRG:Z:run1_lane" + to_string(1 + random() % 8) + "\tXA:Z:";
+        for (auto hit = 0u; hit < 2 + random() % 4; ++hit) {
+            line += to_string(1 + random() % 22) + "," +
+                    (random() % 2 ? "+" : "-") +
+                    to_string(random() % 100000000) + ",150M," +
+                    to_string(random() % 5) + ";";
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// the loop of the Alignment constructor before the tokenizer
+int
+byteLoop(const char *line, int, int length, int, vector<int> &positions) {
+    auto index = 0;
+    for (auto it = line; it != line + length; ++it) {
+        if (*it == '\t') {
+            positions.push_back(index);
+        }
+        ++index;
+    }
+    return static_cast<int>(positions.size());
+}
+
+unsigned long long
+cycleCount() {
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return chrono::duration_cast<chrono::nanoseconds>(
+               chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+void
+run(const string &name, const SamTokenizer::TabScanner &scanner, int maxTabs,
+    const vector<string> &lines, size_t totalBytes) {
+    vector<int> positions;
+    positions.reserve(64);
+    auto checksum = 0L;
+    auto bestCycles = ~0ULL;
+    auto bestSeconds = 0.0;
+    for (auto round = 0; round < ROUNDS; ++round) {
+        auto wallStart = chrono::steady_clock::now();
+        auto start = cycleCount();
+        for (const auto &line : lines) {
+            positions.clear();
+            scanner(line.data(), 0, static_cast<int>(line.size()), maxTabs,
+                    positions);
+            checksum += positions.back();
+        }
+        auto cycles = cycleCount() - start;
+        if (cycles < bestCycles) {
+            bestCycles = cycles;
+            bestSeconds = chrono::duration<double>(chrono::steady_clock::now() -
+                                                   wallStart)
+                              .count();
+        }
+    }
+    cout << left << setw(28) << name << right << fixed << setprecision(2)
+         << setw(10) << static_cast<double>(totalBytes) / bestCycles
+         << setw(12) << bestSeconds * 1e9 / lines.size() << "   (checksum "
+         << checksum << ")" << endl;
+}
+
+} // namespace
+
+int
+main(int argc, char **argv) {
+    vector<string> lines;
+    if (argc > 1) {
+        ifstream samFile{argv[1]};
+        string line;
+        while (getline(samFile, line)) {
+            if (!line.empty() && line[0] != '@') {
+                lines.push_back(line);
+            }
+        }
+    } else {
+        lines = generateLines(200000);
+    }
+    if (lines.empty()) {
+        cerr << "no SAM lines to tokenize" << endl;
+        return 1;
+    }
+    size_t totalBytes{0};
+    for (const auto &line : lines) {
+        totalBytes += line.size();
+    }
+
+    // every scanner has to agree with the byte loop
+    vector<int> expected, positions;
+    for (const auto &line : lines) {
+        expected.clear();
+        byteLoop(line.data(), 0, static_cast<int>(line.size()), 0, expected);
+        for (const auto &scanner : SamTokenizer::getSupportedScanners()) {
+            for (auto maxTabs : {FIELDTABS, 1 << 30}) {
+                positions.clear();
+                scanner.scan(line.data(), 0, static_cast<int>(line.size()),
+                             maxTabs, positions);
+                auto count = min(static_cast<size_t>(maxTabs), expected.size());
+                if (positions.size() != count ||
+                    !equal(positions.begin(), positions.end(),
+                           expected.begin())) {
+                    cerr << scanner.name << " disagrees on " << line << endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    cout << lines.size() << " lines, " << totalBytes / lines.size()
+         << " bytes per line on average" << endl;
+    cout << left << setw(28) << "tokenizer" << right << setw(10)
+         << "bytes/cyc" << setw(12) << "ns/line" << endl;
+    run("byte loop, all tabs", byteLoop, 0, lines, totalBytes);
+    for (const auto &scanner : SamTokenizer::getSupportedScanners()) {
+        run(string{scanner.name} + ", all tabs", scanner.scan, 1 << 30, lines,
+            totalBytes);
+        run(string{scanner.name} + ", first 11 tabs", scanner.scan, FIELDTABS,
+            lines, totalBytes);
+    }
+    return 0;
+}
@@ -24,153 +24,116 @@
 
 #ifndef ALIGNMENT_H_
 #define ALIGNMENT_H_
+#include "BamRecord.h"
 #include "ChosenBp.h"
 #include "CigarChunk.h"
-#include "CoverageAtBase.h"
+#include "CompactAlignment.h"
+#include "SaTag.h"
 #include "SuppAlignment.h"
 #include <OverhangRange.h>
 #include <algorithm>
 #include <deque>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace sophia {
 
 using namespace std;
 
-class Alignment {
+class Alignment : public CompactAlignment {
 
   public:
     Alignment();
-    void continueConstruction();
+    // Alignments are recycled by the SamSegmentMapper, assign replaces the
+    // previous read and keeps the buffers. read is the CompactAlignment of
+    // the same SAM line or BAM record.
+    void assign(const CompactAlignment &read, string_view samLineIn,
+                shared_ptr<const vector<char>> lineBlockIn,
+                const vector<int> &fieldTabs);
+    void assign(const CompactAlignment &read, const BamRecord &record);
+    // mates further apart than isizeMax are distant
+    void continueConstruction(double isizeMax);
     static int LOWQUALCLIPTHRESHOLD, BASEQUALITYTHRESHOLD,
         BASEQUALITYTHRESHOLDLOW, CLIPPEDNUCLEOTIDECOUNTTHRESHOLD,
         INDELNUCLEOTIDECOUNTTHRESHOLD;
-    static double ISIZEMAX;
-    int getStartPos() const { return startPos; }
-    int getEndPos() const { return endPos; }
-    int getReadType() const { return readType; }
     const vector<int> &getReadBreakpoints() const { return readBreakpoints; }
-    bool isValidLine() const { return validLine; }
-    const string &getSamLine() const { return samLine; }
-    const vector<int> &getSamChunkPositions() const {
-        return samChunkPositions;
-    }
-    bool assessOutlierMateDistance();
-    int getMateChrIndex() const { return mateChrIndex; }
-    int getMatePos() const { return matePos; }
+    const string_view &getSamLine() const { return samLine; }
     const vector<char> &getReadBreakpointTypes() const {
         return readBreakpointTypes;
     }
     void setChosenBp(int chosenBpLoc, int alignmentIndex);
-    bool isOverhangEncounteredM() const { return chosenBp->bpEncounteredM; }
-    int getOverhangLength() const { return chosenBp->overhangLength; }
-    int getOverhangStartIndex() const { return chosenBp->overhangStartIndex; }
-    vector<SuppAlignment> generateSuppAlignments(int bpChrIndex, int bpPos);
+    bool isOverhangEncounteredM() const { return chosenBp.bpEncounteredM; }
+    int getOverhangLength() const { return chosenBp.overhangLength; }
+    int getOverhangStartIndex() const { return chosenBp.overhangStartIndex; }
+    vector<SuppAlignment>
+    generateSuppAlignments(int bpChrIndex, int bpPos,
+                           const ReadParameters &readParameters);
     const vector<SuppAlignment> &getSupplementaryAlignments() const {
-        return chosenBp->supplementaryAlignments;
+        return chosenBp.supplementaryAlignments;
     }
-    int getChrIndex() const { return chrIndex; }
     const vector<int> &getReadBreakpointsSizes() const {
         return readBreakpointSizes;
     }
-    bool isLowMapq() const { return lowMapq; }
-    bool isNullMapq() const { return nullMapq; }
-    bool isSupplementary() const { return supplementary; }
-    void addChildNode(int indexIn) { chosenBp->addChildNode(indexIn); }
+    void addChildNode(int indexIn) { chosenBp.addChildNode(indexIn); }
     void
     addSupplementaryAlignments(const vector<SuppAlignment> &suppAlignments) {
-        chosenBp->addSupplementaryAlignments(suppAlignments);
+        chosenBp.addSupplementaryAlignments(suppAlignments);
     }
     const vector<int> &getChildrenNodes() const {
-        return chosenBp->childrenNodes;
+        return chosenBp.childrenNodes;
     }
-    int getOriginIndex() const { return chosenBp->selfNodeIndex; }
+    int getOriginIndex() const { return chosenBp.selfNodeIndex; }
+    // a copy of its own, for a breakpoint finalized on another thread
+    shared_ptr<Alignment> clone() const;
     string printOverhang() const;
     double overhangComplexityMaskRatio() const;
 
-    bool isInvertedMate() const { return invertedMate; }
-    bool isDistantMate() const { return distantMate == 1; }
-
   private:
-    void mappingQualityCheck();
-    bool isEventCandidate() const;
+    struct CigarScan {
+        bool encounteredM;
+        int cumulativeNucleotideCount, indelAdjustment, leftClipAdjustment,
+            rightClipAdjustment;
+    };
+    void clearRead(const CompactAlignment &read);
     void createCigarChunks();
+    void createCigarChunks(const BamRecord &record);
+    void addCigarChunk(char chunkType, int length, CigarScan &scan);
     void assignBreakpointsAndOverhangs();
     void qualityCheckCascade();
     bool clipCountCheck();
+    void decodeSaTag();
     bool uniqueSuppCheck();
     double overhangMedianQuality(const CigarChunk &cigarChunk) const;
-    template <typename Iterator>
-    void fullMedianQuality(Iterator qualBegin, Iterator qualEnd,
-                           vector<int> &overhangPerBaseQuality) const;
-    template <typename Iterator>
-    double getMedian(Iterator begin, Iterator end) const;
     void assessReadType();
-    bool lowMapq;
-    bool nullMapq;
-    int distantMate;
-    unique_ptr<ChosenBp> chosenBp;
-    int chrIndex;
-    int readType;
-    int startPos, endPos;
-    int mateChrIndex, matePos;
-    string samLine;
-    bool validLine;
+    ChosenBp chosenBp;
+    // SAM input lines are views into the block of the SamLineReader, which
+    // is kept alive for as long as the alignment
+    string_view samLine;
+    shared_ptr<const vector<char>> lineBlock;
+    // the tabs of the optional tags are only added by uniqueSuppCheck
     vector<int> samChunkPositions;
-    string::const_iterator saCbegin, saCend;
+    // the SA tag decoded once by uniqueSuppCheck, kept across the reuse of
+    // pooled alignments
+    vector<SaEntry> saEntries;
     bool hasSa;
-    bool supplementary;
-    bool fwdStrand;
-    bool invertedMate;
     bool qualChecked;
     vector<CigarChunk> cigarChunks;
     vector<int> readBreakpoints;
     vector<char> readBreakpointTypes;
     vector<int> readBreakpointSizes;
     vector<double> readBreakpointComplexityMaskRatios;
-    deque<bool> readBreakpointsEncounteredM;
+    vector<bool> readBreakpointsEncounteredM;
     vector<OverhangRange> readOverhangCoords;
+    // for BAM input samLine only views SEQ, QUAL and the SA tag value of
+    // event candidates in decodedFields
+    bool fromBamRecord;
+    string decodedFields;
+    int sequenceStart, qualityStart, qualityEnd;
+    int saTagStart, saTagEnd;
 };
 
-template <typename Iterator>
-void
-Alignment::fullMedianQuality(Iterator qualBegin, Iterator qualEnd,
-                             vector<int> &overhangPerBaseQuality) const {
-    overhangPerBaseQuality.reserve(distance(qualBegin, qualEnd));
-    auto consecutiveLowQuals = 0;
-    for (auto cit = qualBegin; cit != qualEnd; ++cit) {
-        if (*cit < BASEQUALITYTHRESHOLDLOW) {   // 33 + phred 11
-            if (consecutiveLowQuals == 5) {
-                overhangPerBaseQuality.clear();
-                return;
-            }
-            ++consecutiveLowQuals;
-        } else {
-            consecutiveLowQuals = 0;
-        }
-        overhangPerBaseQuality.push_back(*cit);
-    }
-}
-
-// Median Code taken from http://rosettacode.org/wiki/Averages/Median#C.2B.2B
-template <typename Iterator>
-double
-Alignment::getMedian(Iterator begin, Iterator end) const {
-    // this is middle for odd-length, and "upper-middle" for even length
-    Iterator middle = begin + (end - begin) / 2;
-    // This function runs in O(n) on average, according to the standard
-    nth_element(begin, middle, end);
-    if ((end - begin) % 2 != 0) {   // odd length
-        return *middle;
-    } else {   // even length
-        // the "lower middle" is the max of the lower half
-        Iterator lower_middle = max_element(begin, middle);
-        return (*middle + *lower_middle) / 2.0;
-    }
-}
-
 } /* namespace sophia */
 
 #endif /* ALIGNMENT_H_ */
@@ -0,0 +1,59 @@
+/*
+ * BamIndex.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef BAMINDEX_H_
+#define BAMINDEX_H_
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// The BAI index of a coordinate sorted BAM file, reduced to where the records
+// of every reference start. The index is looked for as <bam>.bai and with the
+// .bam extension replaced by .bai.
+class BamIndex {
+  public:
+    BamIndex(const string &bamFileName);
+    // virtual file offset of the first record of the reference, 0 if the
+    // reference has no records
+    uint64_t getFirstOffset(int refId) const;
+    // a virtual file offset before every record of the reference starting at
+    // pos or later, 0 if the linear index does not tell
+    uint64_t getOffset(int refId, int pos) const;
+
+  private:
+    static const int WINDOWSHIFT = 14;
+    static const uint32_t PSEUDOBIN = 37450;
+    template <typename T> T readValue();
+    string fileName;
+    FILE *fileHandle;
+    vector<uint64_t> firstOffsets;
+    // the smallest offset of the records overlapping every 16 kbp window
+    vector<vector<uint64_t>> linearOffsets;
+};
+
+} /* namespace sophia */
+
+#endif /* BAMINDEX_H_ */
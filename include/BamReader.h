@@ -0,0 +1,55 @@
+/*
+ * BamReader.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef BAMREADER_H_
+#define BAMREADER_H_
+#include "BgzfReader.h"
+#include "RecordReader.h"
+#include <string>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+class BamReader : public RecordReader {
+  public:
+    BamReader(const string &fileNameIn, int threadsIn);
+    // reads the header, then continues with the records from the virtual
+    // file offset startOffset, as told by tell()
+    BamReader(const string &fileNameIn, int threadsIn, uint64_t startOffset);
+    ~BamReader() = default;
+    bool nextRecord(BamRecord &record) override;
+    // continues at a virtual file offset of the BAM index
+    void seek(uint64_t virtualOffset) { bgzfReader.seek(virtualOffset); }
+    uint64_t tell() const override { return bgzfReader.tell(); }
+
+  private:
+    void readHeader(BgzfReader &headerReader);
+    int32_t readInt32(BgzfReader &headerReader);
+    const string fileName;
+    BgzfReader bgzfReader;
+    vector<char> recordBuffer;
+};
+
+} /* namespace sophia */
+
+#endif /* BAMREADER_H_ */
@@ -0,0 +1,184 @@
+/*
+ * BamRecord.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef BAMRECORD_H_
+#define BAMRECORD_H_
+#include <cstdint>
+#include <cstring>
+
+namespace sophia {
+
+// Non-owning view of one binary BAM alignment record (without the leading
+// block_size), plus the ChrConverter indices of its reference and mate
+// reference. BAM is little-endian, as are all platforms sophia is built for.
+class BamRecord {
+  public:
+    BamRecord()
+        : data{nullptr}, length{0}, chrIndex{0}, mateChrIndex{0},
+          cigarOffset{0}, sequenceOffset{0}, qualityOffset{0}, tagsOffset{0} {}
+    void assign(const char *dataIn, int lengthIn) {
+        data = dataIn;
+        length = lengthIn;
+        cigarOffset = 32 + static_cast<unsigned char>(data[8]);
+        sequenceOffset = cigarOffset + 4 * getCigarOperationCount();
+        qualityOffset = sequenceOffset + (getSequenceLength() + 1) / 2;
+        tagsOffset = qualityOffset + getSequenceLength();
+    }
+    void setChrIndices(int chrIndexIn, int mateChrIndexIn) {
+        chrIndex = chrIndexIn;
+        mateChrIndex = mateChrIndexIn;
+    }
+    bool isWellFormed() const {
+        return length >= 32 && getSequenceLength() >= 0 && tagsOffset <= length;
+    }
+    const char *getData() const { return data; }
+    int getLength() const { return length; }
+    int getChrIndex() const { return chrIndex; }
+    int getMateChrIndex() const { return mateChrIndex; }
+    int getRefId() const { return readInt32(0); }
+    // 0-based leftmost position
+    int getPos() const { return readInt32(4); }
+    int getMapq() const { return static_cast<unsigned char>(data[9]); }
+    int getCigarOperationCount() const { return readUint16(12); }
+    int getFlag() const { return readUint16(14); }
+    int getSequenceLength() const { return readInt32(16); }
+    int getMateRefId() const { return readInt32(20); }
+    int getMatePos() const { return readInt32(24); }
+    int getTemplateLength() const { return readInt32(28); }
+    char getCigarOperationType(int i) const {
+        return CIGAROPERATIONS[readUint32(cigarOffset + 4 * i) & 0xf];
+    }
+    int getCigarOperationLength(int i) const {
+        return static_cast<int>(readUint32(cigarOffset + 4 * i) >> 4);
+    }
+    char getBase(int i) const {
+        auto packed = static_cast<unsigned char>(data[sequenceOffset + i / 2]);
+        return BASES[(i % 2 == 0) ? (packed >> 4) : (packed & 0xf)];
+    }
+    // raw phred value, 0xff if the record carries no qualities
+    int getQuality(int i) const {
+        return static_cast<unsigned char>(data[qualityOffset + i]);
+    }
+    // same criterion as CompactAlignment::hasClipsOrIndels on the SAM
+    // CIGAR: reads without an alignment, or with clips or indels
+    bool isEventCandidate() const {
+        auto operationCount = getCigarOperationCount();
+        if (operationCount == 0 ||
+            getCigarOperationType(operationCount - 1) != 'M') {
+            return true;
+        }
+        for (auto i = 0; i < operationCount - 1; ++i) {
+            switch (getCigarOperationType(i)) {
+            case 'S':
+            case 'H':
+            case 'I':
+            case 'D':
+                return true;
+            default:
+                break;
+            }
+        }
+        return false;
+    }
+    // value of a Z (string) tag, nullptr if the tag is absent
+    const char *findStringTag(char first, char second) const {
+        auto i = tagsOffset;
+        while (i + 3 <= length) {
+            auto type = data[i + 2];
+            if (data[i] == first && data[i + 1] == second && type == 'Z') {
+                return data + i + 3;
+            }
+            i += 3;
+            auto size = tagValueSize(type, i);
+            if (size < 0) {
+                return nullptr;
+            }
+            i += size;
+        }
+        return nullptr;
+    }
+
+  private:
+    static constexpr const char *CIGAROPERATIONS = "MIDNSHP=X???????";
+    static constexpr const char *BASES = "=ACMGRSVTWYHKDBN";
+    int tagValueSize(char type, int valueOffset) const {
+        switch (type) {
+        case 'A':
+        case 'c':
+        case 'C':
+            return 1;
+        case 's':
+        case 'S':
+            return 2;
+        case 'i':
+        case 'I':
+        case 'f':
+            return 4;
+        case 'Z':
+        case 'H': {
+            auto end = static_cast<const char *>(
+                memchr(data + valueOffset, '\0', length - valueOffset));
+            return end == nullptr ? -1
+                                  : static_cast<int>(end - data) - valueOffset +
+                                        1;
+        }
+        case 'B': {
+            if (valueOffset + 5 > length) {
+                return -1;
+            }
+            auto elementSize = tagValueSize(data[valueOffset], valueOffset);
+            return elementSize < 0 ? -1
+                                   : 5 + elementSize *
+                                             static_cast<int>(readUint32(
+                                                 valueOffset + 1));
+        }
+        default:
+            return -1;
+        }
+    }
+    int readInt32(int offset) const {
+        int32_t value;
+        memcpy(&value, data + offset, sizeof(value));
+        return value;
+    }
+    uint32_t readUint32(int offset) const {
+        uint32_t value;
+        memcpy(&value, data + offset, sizeof(value));
+        return value;
+    }
+    int readUint16(int offset) const {
+        uint16_t value;
+        memcpy(&value, data + offset, sizeof(value));
+        return value;
+    }
+    const char *data;
+    int length;
+    int chrIndex;
+    int mateChrIndex;
+    int cigarOffset;
+    int sequenceOffset;
+    int qualityOffset;
+    int tagsOffset;
+};
+
+} /* namespace sophia */
+
+#endif /* BAMRECORD_H_ */
@@ -0,0 +1,50 @@
+/*
+ * BedReader.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+
+#ifndef BEDREADER_H_
+#define BEDREADER_H_
+#include <fstream>
+#include <string>
+
+namespace sophia {
+
+using namespace std;
+
+// Reads the intervals of a BED file, skipping empty, comment, track and
+// browser lines. Terminates if the file cannot be opened or a line has no
+// valid interval.
+class BedReader {
+  public:
+    explicit BedReader(const string &fileNameIn);
+    // the next interval, zero based and half open. False at the end of the
+    // file.
+    bool nextInterval(string &contig, int &start, int &end);
+
+  private:
+    const string fileName;
+    ifstream bedFile;
+};
+
+} /* namespace sophia */
+
+#endif /* BEDREADER_H_ */
@@ -0,0 +1,95 @@
+/*
+ * BgzfReader.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef BGZFREADER_H_
+#define BGZFREADER_H_
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Sequential reader for BGZF files (BAM). With more than one thread, an I/O
+// thread reads the compressed blocks in file order, a pool of worker threads
+// inflates them and read() hands out the inflated bytes in the original
+// order. With a single thread the blocks are inflated inline.
+class BgzfReader {
+  public:
+    BgzfReader(const string &fileNameIn, int threadsIn);
+    // starts at a virtual file offset, see tell()
+    BgzfReader(const string &fileNameIn, int threadsIn, uint64_t startOffset);
+    ~BgzfReader();
+    BgzfReader(const BgzfReader &) = delete;
+    BgzfReader &operator=(const BgzfReader &) = delete;
+    // copies exactly length bytes into dest. Returns false on a clean EOF,
+    // terminates on a truncated or corrupt file.
+    bool read(char *dest, size_t length);
+    // continues at a virtual file offset (compressed block offset << 16 |
+    // offset in the inflated block), as stored in BAM indices. Only readers
+    // without worker threads can seek.
+    void seek(uint64_t virtualOffset);
+    // the virtual file offset of the next byte
+    uint64_t tell() const;
+
+  private:
+    struct Block {
+        uint64_t fileOffset;
+        vector<unsigned char> compressed;
+        vector<char> inflated;
+        bool ready;
+    };
+    bool nextBlock();
+    bool readCompressedBlock(Block &block);
+    void inflateBlock(Block &block) const;
+    void ioLoop();
+    void workerLoop();
+    [[noreturn]] void formatError(const string &reason) const;
+    const string fileName;
+    const int THREADS;
+    FILE *fileHandle;
+    // of the next compressed block, only touched by the thread reading them
+    uint64_t nextFileOffset;
+    vector<unique_ptr<Block>> blockPool;
+    Block *currentBlock;
+    size_t currentIndex;
+    mutex queueMutex;
+    condition_variable blockReady;
+    condition_variable workAvailable;
+    condition_variable slotAvailable;
+    vector<Block *> freeBlocks;
+    deque<Block *> pendingBlocks;
+    deque<Block *> inflateQueue;
+    bool endOfFile;
+    bool shuttingDown;
+    vector<thread> threadPool;
+};
+
+} /* namespace sophia */
+
+#endif /* BGZFREADER_H_ */
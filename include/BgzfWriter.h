@@ -0,0 +1,58 @@
+/*
+ * BgzfWriter.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef BGZFWRITER_H_
+#define BGZFWRITER_H_
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Sequential writer for BGZF files, which bgzip, tabix and BgzfReader read.
+// The bytes are compressed in blocks of at most BLOCKINPUT bytes, and the
+// empty end of file block is added when the writer is destroyed.
+class BgzfWriter {
+  public:
+    explicit BgzfWriter(const string &fileNameIn);
+    ~BgzfWriter();
+    BgzfWriter(const BgzfWriter &) = delete;
+    BgzfWriter &operator=(const BgzfWriter &) = delete;
+    void write(const char *data, size_t length);
+    void write(const string &text) { write(text.data(), text.size()); }
+
+  private:
+    // as in htslib, so that a block compresses into the 64 kb BGZF limit
+    static const size_t BLOCKINPUT = 0xff00;
+    void writeBlock();
+    [[noreturn]] void writeError() const;
+    const string fileName;
+    FILE *fileHandle;
+    vector<char> pending;
+    vector<unsigned char> compressed;
+};
+
+} /* namespace sophia */
+
+#endif /* BGZFWRITER_H_ */
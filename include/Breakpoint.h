@@ -25,7 +25,10 @@
 #ifndef BREAKPOINT_H_
 #define BREAKPOINT_H_
 #include "Alignment.h"
-#include "MateInfo.h"
+#include "BreakpointOutput.h"
+#include "MatePool.h"
+#include "PackedOverhang.h"
+#include "ReadParameters.h"
 #include "SuppAlignment.h"
 #include "SuppAlignmentAnno.h"
 #include <memory>
@@ -39,27 +42,53 @@ using namespace std;
 
 class Breakpoint {
   public:
-    Breakpoint(int chrIndexIn, int posIn);
+    // readParametersIn are those of the sample mapped, they have to outlive
+    // the breakpoint
+    Breakpoint(int chrIndexIn, int posIn,
+               const ReadParameters &readParametersIn);
     Breakpoint(const string &bpIn, bool ignoreOverhang);
     ~Breakpoint() = default;
+    Breakpoint(Breakpoint &&) = default;
+    Breakpoint &operator=(Breakpoint &&) = default;
     static const int PERMISSIBLEMISMATCHES = 2;
     static const int MAXPERMISSIBLESOFTCLIPS = 2000;
     static const int MAXPERMISSIBLEHARDCLIPS = 2000;
     static const int MAXPERMISSIBLELOWMAPQHARDCLIPS = 50;
+    // the size of the reservoir sample of the soft and hard clipped reads
+    // when the window is over its memory budget
+    static const int SAMPLEDCLIPS = 200;
     static int BPSUPPORTTHRESHOLD;
+    // the read length of the breakpoint files sophiaAnnotate parses
     static int DEFAULTREADLENGTH;
-    static int DISCORDANTLOWQUALLEFTRANGE;
-    static int DISCORDANTLOWQUALRIGHTRANGE;
     static double IMPROPERPAIRRATIO;
     static bool PROPERPAIRCOMPENSATIONMODE;
-    static int bpindex;
     static const string COLUMNSSTR;
-    void addSoftAlignment(shared_ptr<Alignment> alignmentIn);
-    void addHardAlignment(shared_ptr<Alignment> alignmentIn);
-    bool finalizeBreakpoint(
-        const deque<MateInfo> &discordantAlignmentsPool,
-        const deque<MateInfo> &discordantLowQualAlignmentsPool,
-        const deque<MateInfo> &discordantAlignmentCandidatesPool);
+    // With sampling, the clipped reads beyond SAMPLEDCLIPS are kept as a
+    // reservoir sample of all reads added, the same for every run. Both
+    // return the change of getRetainedAlignments().
+    int addSoftAlignment(shared_ptr<Alignment> alignmentIn, bool sampling);
+    int addHardAlignment(shared_ptr<Alignment> alignmentIn, bool sampling);
+    int getRetainedAlignments() const {
+        return static_cast<int>(supportingSoftAlignments.size() +
+                                supportingHardAlignments.size() +
+                                supportingHardLowMapqAlignments.size());
+    }
+    // The finalization is split in two steps. The first takes the overhang
+    // index from output and refers to the mates of the pools around pos, so
+    // the breakpoints have to pass it in position order. It is false if the
+    // breakpoint is dropped already.
+    bool prepareFinalization(const MatePool &discordantAlignmentsPool,
+                             const MatePool &discordantLowQualAlignmentsPool,
+                             const MatePool &discordantAlignmentCandidatesPool,
+                             BreakpointOutput &output);
+    bool hasOverhangIndex() const { return overhangIndex != 0; }
+    // pins the chunks of the pools it refers to, which the pools may drop
+    // meanwhile, and copies the alignments it shares with other breakpoints,
+    // for the second step to run on another thread
+    void detachFromPools(const MatePool &discordantAlignmentsPool,
+                         const MatePool &discordantLowQualAlignmentsPool);
+    // the second step, false if there is nothing to report
+    bool completeFinalization(string &report);
     void setLeftCoverage(int leftCoverageIn) { leftCoverage = leftCoverageIn; }
     void setRightCoverage(int rightCoverageIn) {
         rightCoverage = rightCoverageIn;
@@ -191,23 +220,36 @@ class Breakpoint {
     void setHitsInMref(int hitsInMref) { this->hitsInMref = hitsInMref; }
 
   private:
-    string finalizeOverhangs();
-    void printBreakpointReport(const string &overhangStr);
-    bool matchDetector(const shared_ptr<Alignment> &longAlignment,
-                       const shared_ptr<Alignment> &shortAlignment) const;
+    string finalizeOverhangs(int index);
+    string printBreakpointReport(const string &overhangStr) const;
+    bool matchDetector(const PackedOverhang &longOverhang,
+                       const PackedOverhang &shortOverhang) const;
     void detectDoubleSupportSupps();
     void collapseSuppRange(string &res, const vector<SuppAlignment> &vec) const;
     template <typename T> void cleanUpVector(vector<T> &objectPool);
-    void fillMatePool(const deque<MateInfo> &discordantAlignmentsPool,
-                      const deque<MateInfo> &discordantLowQualAlignmentsPool,
-                      const deque<MateInfo> &discordantAlignmentCandidatesPool);
+    // refers to the mates of the pools around pos, the pools have to stay
+    // unchanged until the breakpoint is finalized
+    void fillMatePool(const MatePool &discordantAlignmentsPool,
+                      const MatePool &discordantLowQualAlignmentsPool,
+                      const MatePool &discordantAlignmentCandidatesPool);
+    // the mates of the breakpoint's own alignments, which stand for the
+    // reads sampled out with them
+    void addOwnMate(vector<const MateInfo *> &pool, const Alignment &alignment,
+                    int source);
+    void addOwnMate(vector<MateInfoRef> &pool, const Alignment &alignment,
+                    int source);
+    void weighOwnMate(MateInfo &mateInfo, const Alignment &alignment,
+                      int source) const;
     void collectMateSupport();
-    void compressMatePool(vector<MateInfo> &discordantAlignmentsPool);
-    void
-    collectMateSupportHelper(SuppAlignment &sa,
-                             vector<MateInfo> &discordantAlignmentsPool,
-                             vector<MateInfo> &discordantLowQualAlignmentsPool);
+    // the clusters of the mates, which are sorted by mate position
+    void compressMatePool(const vector<const MateInfo *> &mates,
+                          vector<MateInfo> &clusters) const;
+    void collectMateSupportHelper(
+        SuppAlignment &sa, vector<MateInfo> &discordantAlignmentsPool,
+        vector<MateInfoRef> &discordantLowQualAlignmentsPool);
     void saHomologyClashSolver();
+    // nullptr for the breakpoints parsed from a file
+    const ReadParameters *readParameters;
     bool covFinalized;
     bool missingInfoBp;
     int chrIndex;
@@ -220,15 +262,28 @@ class Breakpoint {
     int mateSupport;
     int leftCoverage, rightCoverage;
     int totalLowMapqHardClips;
+    // all soft and hard clipped reads added, sampled out ones included
+    int softAlignmentCount, hardAlignmentCount;
+    // whether the clipped reads were sampled, and the reads added per read
+    // kept, by which the counts taken from the kept reads are scaled up
+    bool softSampled, hardSampled;
+    double softSampleScale, hardSampleScale;
     int hitsInMref;
     bool germline;
+    // the totals before finalization, and the overhang index of breakpoints
+    // with enough information to finalize their overhangs
+    int eventTotal, artifactTotal;
+    int overhangIndex;
     vector<shared_ptr<Alignment>> supportingSoftAlignments;
     vector<shared_ptr<Alignment>> supportingHardAlignments;
     vector<shared_ptr<Alignment>> supportingHardLowMapqAlignments;
     vector<SuppAlignment> supplementsPrimary;
     vector<SuppAlignment> doubleSidedMatches;
     vector<string> consensusOverhangs;
-    vector<MateInfo> poolLeft, poolRight, poolLowQualLeft, poolLowQualRight;
+    vector<const MateInfo *> poolLeft, poolRight;
+    vector<MateInfoRef> poolLowQualLeft, poolLowQualRight;
+    deque<MateInfo> ownMates;
+    vector<shared_ptr<const MatePool::Chunk>> pinnedChunks;
     vector<SuppAlignment> supplementsSecondary;
 };
 
@@ -0,0 +1,91 @@
+/*
+ * BreakpointFinalizer.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef BREAKPOINTFINALIZER_H_
+#define BREAKPOINTFINALIZER_H_
+#include "Breakpoint.h"
+#include "BreakpointOutput.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Completes the finalization of the breakpoints that SamSegmentMapper
+// prepared in position order, and writes their reports in that order. With
+// more than one thread, the breakpoints with overhangs to finalize pin the
+// chunks of the mate pools and are finalized by a pool of worker threads,
+// and their reports wait in submission order until the breakpoints before
+// are done. With a single thread every breakpoint is finalized inline.
+class BreakpointFinalizer {
+  public:
+    BreakpointFinalizer(int threadsIn, BreakpointOutput &outputIn);
+    ~BreakpointFinalizer();
+    BreakpointFinalizer(const BreakpointFinalizer &) = delete;
+    BreakpointFinalizer &operator=(const BreakpointFinalizer &) = delete;
+    // takes a breakpoint for which prepareFinalization returned true with
+    // the same pools, it may be moved from. Returns the number of reports
+    // written by the call.
+    unsigned int submit(Breakpoint &breakpoint,
+                        const MatePool &discordantAlignmentsPool,
+                        const MatePool &discordantLowQualAlignmentsPool);
+    // waits for all submitted breakpoints and writes their reports
+    unsigned int drain() { return writeFinished(0); }
+
+  private:
+    struct Job {
+        explicit Job(Breakpoint &&breakpointIn)
+            : breakpoint{move(breakpointIn)}, report{}, reported{false},
+              done{false} {}
+        Breakpoint breakpoint;
+        string report;
+        bool reported;
+        bool done;
+    };
+    // writes the reports of the finished jobs at the front, waiting for the
+    // front job while more than keptJobs are pending
+    unsigned int writeFinished(size_t keptJobs);
+    void workerLoop();
+    const int THREADS;
+    const size_t MAXPENDINGJOBS;
+    BreakpointOutput &output;
+    // in submission order, only touched by the submitting thread. The jobs
+    // are also destroyed there, which releases their alignments and
+    // the chunks of the mate pools they pin.
+    deque<unique_ptr<Job>> pendingJobs;
+    mutex queueMutex;
+    condition_variable workAvailable;
+    condition_variable jobDone;
+    deque<Job *> workQueue;
+    bool shuttingDown;
+    vector<thread> threadPool;
+};
+
+} /* namespace sophia */
+
+#endif /* BREAKPOINTFINALIZER_H_ */
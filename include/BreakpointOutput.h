@@ -0,0 +1,67 @@
+/*
+ * BreakpointOutput.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef BREAKPOINTOUTPUT_H_
+#define BREAKPOINTOUTPUT_H_
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace sophia {
+
+using namespace std;
+
+// Destination of the breakpoint reports of a SamSegmentMapper, and the
+// running index of the breakpoints whose significant overhangs are numbered
+// ">index_n". The reports are written straight to the stream, or buffered
+// when the chromosome groups of an indexed BAM file are mapped in parallel.
+// Buffered reports are numbered from 1 and shifted by the number of
+// breakpoints indexed in the groups before when they are written out.
+class BreakpointOutput {
+  public:
+    BreakpointOutput(bool bufferedIn, ostream &streamIn);
+    int takeIndex() { return ++indexCount; }
+    int getIndexCount() const { return indexCount; }
+    void write(const string &report);
+    // writes out the buffered reports with their overhang ids shifted by
+    // indexOffset
+    void flush(int indexOffset);
+    // the bytes of the reports written to the stream
+    uint64_t getWrittenBytes() const { return writtenBytes; }
+    // hands the written reports on to the file
+    void sync() { stream.flush(); }
+    // continues the index and the byte count of an interrupted run
+    void restore(int indexCountIn, uint64_t writtenBytesIn) {
+        indexCount = indexCountIn;
+        writtenBytes = writtenBytesIn;
+    }
+
+  private:
+    const bool BUFFERED;
+    ostream &stream;
+    int indexCount;
+    uint64_t writtenBytes;
+    string buffer;
+};
+
+} /* namespace sophia */
+
+#endif /* BREAKPOINTOUTPUT_H_ */
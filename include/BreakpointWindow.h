@@ -0,0 +1,109 @@
+/*
+ * BreakpointWindow.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef BREAKPOINTWINDOW_H_
+#define BREAKPOINTWINDOW_H_
+#include "Breakpoint.h"
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// The open breakpoints of SamSegmentMapper, from firstPos to lastPos. Every
+// position has a slot of its own in a ring with a power of two capacity,
+// indexed by the position masked with it, so a breakpoint is found or added
+// without a search or an allocation of its own, and the breakpoints are
+// visited in position order by walking the slots. A breakpoint further away
+// from the others than the capacity doubles it, up to MAXCAPACITY. The
+// breakpoints beyond that, such as those of a read spanning a long deletion
+// or intron, are kept in a map next to the ring instead.
+class BreakpointWindow {
+  public:
+    BreakpointWindow(int expectedLength);
+    bool isEmpty() const { return count == 0 && farBreakpoints.empty(); }
+    // the breakpoint at pos, added for chrIndex unless there is one already
+    Breakpoint &findOrAdd(int chrIndex, int pos,
+                          const ReadParameters &readParameters);
+    // the first breakpoint, the window must not be empty
+    int getFirstPos() const {
+        if (farBreakpoints.empty() ||
+            (count != 0 && firstPos < farBreakpoints.begin()->first)) {
+            return firstPos;
+        }
+        return farBreakpoints.begin()->first;
+    }
+    Breakpoint &getFirst() {
+        if (farBreakpoints.empty() ||
+            (count != 0 && firstPos < farBreakpoints.begin()->first)) {
+            return *slots[firstPos & mask];
+        }
+        return farBreakpoints.begin()->second;
+    }
+    void popFirst();
+    // calls visit(pos, breakpoint) for the breakpoints in [fromPos, toPos] in
+    // position order
+    template <typename Visit>
+    void forEachIn(int fromPos, int toPos, Visit visit) {
+        auto far = farBreakpoints.lower_bound(fromPos);
+        // the breakpoints of the map up to pos, in between those of the ring
+        auto visitFarUpTo = [&](int pos) {
+            for (; far != farBreakpoints.end() && far->first <= pos; ++far) {
+                visit(far->first, far->second);
+            }
+        };
+        if (count != 0) {
+            auto lastVisited = min(toPos, lastPos);
+            for (auto pos = max(fromPos, firstPos); pos <= lastVisited;
+                 ++pos) {
+                auto &slot = slots[pos & mask];
+                if (slot) {
+                    if (far != farBreakpoints.end()) {
+                        visitFarUpTo(pos - 1);
+                    }
+                    visit(pos, *slot);
+                }
+            }
+        }
+        visitFarUpTo(toPos);
+    }
+    // also returns the ring to its initial capacity
+    void clear();
+
+  private:
+    // far more positions than the window of short reads spans
+    static const int MAXCAPACITY = 1 << 14;
+    void grow(int length);
+    const int INITIALCAPACITY;
+    int mask;
+    int firstPos, lastPos;
+    int count;
+    vector<optional<Breakpoint>> slots;
+    map<int, Breakpoint> farBreakpoints;
+};
+
+} /* namespace sophia */
+
+#endif /* BREAKPOINTWINDOW_H_ */
@@ -0,0 +1,71 @@
+/*
+ * Checkpoint.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+#include <cstdint>
+#include <string>
+
+namespace sophia {
+
+using namespace std;
+
+// The state of a SamSegmentMapper at the start of a chromosome, from which
+// a later run on the same input resumes. It is saved as a small text file,
+// replaced as a whole, once the reports of the chromosomes before are
+// written out. A run saves a first one for its first record, with no
+// chromosome completed, and one marked finished at the end of the input.
+class Checkpoint {
+  public:
+    Checkpoint(const string &fileNameIn, const string &inputFileIn);
+    // reads the state saved by an earlier run on the same input
+    void load();
+    // the chromosome lastChrIndex is completed, 0 for none, and the next
+    // one starts at the virtual file offset inputOffset of the input
+    void save(int lastChrIndexIn, uint64_t inputOffsetIn, int indexCountIn,
+              uint64_t outputBytesIn);
+    void saveFinished(int lastChrIndexIn, int indexCountIn,
+                      uint64_t outputBytesIn);
+    bool isFinished() const { return finished; }
+    int getLastChrIndex() const { return lastChrIndex; }
+    uint64_t getInputOffset() const { return inputOffset; }
+    // of the overhangs numbered ">index_n" so far
+    int getIndexCount() const { return indexCount; }
+    // of the reports written so far, without the header
+    uint64_t getOutputBytes() const { return outputBytes; }
+
+  private:
+    void write() const;
+    [[noreturn]] void formatError(const string &reason) const;
+    const string fileName;
+    const string inputFile;
+    int lastChrIndex;
+    uint64_t inputOffset;
+    int indexCount;
+    uint64_t outputBytes;
+    bool finished;
+};
+
+} /* namespace sophia */
+
+#endif /* CHECKPOINT_H_ */
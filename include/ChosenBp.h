@@ -36,13 +36,10 @@ class ChosenBp {
     friend class Alignment;
 
   public:
-    ChosenBp(char bpTypeIn, int bpSizeIn, bool bpEncounteredMIn,
-             int overhangStartIndexIn, int overhangLengthIn,
-             int selfNodeIndexIn)
-        : bpType{bpTypeIn}, bpSize{bpSizeIn}, bpEncounteredM{bpEncounteredMIn},
-          overhangStartIndex{overhangStartIndexIn},
-          overhangLength{overhangLengthIn}, supplementaryAlignments{},
-          childrenNodes{{selfNodeIndexIn}}, selfNodeIndex{selfNodeIndexIn} {}
+    ChosenBp()
+        : bpType{}, bpSize{0}, bpEncounteredM{false}, overhangStartIndex{0},
+          overhangLength{0}, supplementaryAlignments{}, childrenNodes{},
+          selfNodeIndex{0} {}
     ~ChosenBp() = default;
     static int BPSUPPORTTHRESHOLD;
 
@@ -54,6 +51,10 @@ class ChosenBp {
     vector<SuppAlignment> supplementaryAlignments;
     vector<int> childrenNodes;
     int selfNodeIndex;
+    // replaces the previously chosen breakpoint, keeping the vector buffers
+    void assign(char bpTypeIn, int bpSizeIn, bool bpEncounteredMIn,
+                int overhangStartIndexIn, int overhangLengthIn,
+                int selfNodeIndexIn);
     void addChildNode(int indexIn);
     void
     addSupplementaryAlignments(const vector<SuppAlignment> &suppAlignments);
@@ -35,8 +35,8 @@ using namespace std;
 
 class ChrConverter {
   public:
-    static inline int readChromosomeIndex(string::const_iterator startIt,
-                                          char stopChar) {
+    template <typename Iterator>
+    static inline int readChromosomeIndex(Iterator startIt, char stopChar) {
         int chrIndex{0};
         if (isdigit(*startIt)) {
             for (auto chr_cit = startIt; *chr_cit != stopChar; ++chr_cit) {
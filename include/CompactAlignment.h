@@ -0,0 +1,90 @@
+/*
+ * CompactAlignment.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef COMPACTALIGNMENT_H_
+#define COMPACTALIGNMENT_H_
+#include "BamRecord.h"
+#include <string_view>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// The fields of an alignment that the coverage profiles and the discordant
+// mate pools need. Reads whose CIGAR has no clips or indels never become
+// breakpoint evidence, so they are classified on this record alone and never
+// turn into an Alignment, which extends it for the event candidates.
+class CompactAlignment {
+  public:
+    // tabs up to the one following QUAL
+    static const int FIELDTABS = 11;
+    // fieldTabs holds the first FIELDTABS tab positions of samLine
+    CompactAlignment(string_view samLine, const vector<int> &fieldTabs);
+    CompactAlignment(const BamRecord &record);
+    // read type 0, 4 for a distant mate or 5 for a low mapping quality of a
+    // read that is no event candidate, mates further apart than isizeMax are
+    // distant
+    void classifyPlainRead(double isizeMax);
+    bool assessOutlierMateDistance();
+    int getChrIndex() const { return chrIndex; }
+    int getStartPos() const { return startPos; }
+    int getEndPos() const { return endPos; }
+    int getReadType() const { return readType; }
+    int getMateChrIndex() const { return mateChrIndex; }
+    int getMatePos() const { return matePos; }
+    bool isEventCandidate() const { return eventCandidate; }
+    bool isLowMapq() const { return lowMapq; }
+    bool isNullMapq() const { return nullMapq; }
+    bool isSupplementary() const { return supplementary; }
+    bool isInvertedMate() const { return invertedMate; }
+    bool isDistantMate() const { return distantMate == 1; }
+
+  protected:
+    CompactAlignment();
+    void markDistantMate();
+    bool lowMapq;
+    bool nullMapq;
+    int distantMate;
+    int chrIndex;
+    int readType;
+    int startPos, endPos;
+    int mateChrIndex, matePos;
+    bool supplementary;
+    bool fwdStrand;
+    bool invertedMate;
+    bool eventCandidate;
+    int readLength;
+    bool mateOnDifferentChromosome;
+    int insertSize;
+    // set by the classification, which is given the isizeMax of the sample
+    bool beyondIsizeMax;
+
+  private:
+    void mappingQualityCheck(int mapq);
+    void decodeFlag(int flag);
+    static bool hasClipsOrIndels(string_view samLine,
+                                 const vector<int> &fieldTabs);
+};
+
+} /* namespace sophia */
+
+#endif /* COMPACTALIGNMENT_H_ */
@@ -0,0 +1,150 @@
+/*
+ * CoverageWindow.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef COVERAGEWINDOW_H_
+#define COVERAGEWINDOW_H_
+#include <array>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// The per base counters of the positions from minPos to maxPos that
+// SamSegmentMapper still needs. Every counter is an array of its own, used as
+// a ring buffer with a power of two capacity and indexed by the position
+// masked with it, so sliding the window only moves minPos. A read reaching
+// beyond the capacity doubles it. The span counters, coverage included, hold
+// differences to the previous position from summedTo on, so a span costs two
+// updates whatever its length. They are summed up when the window slides or
+// when sumUpTo asks for them, maxPos + 1 keeps the ends of the last spans.
+class CoverageWindow {
+  public:
+    CoverageWindow(int expectedLength);
+    bool isEmpty() const { return minPos == -1; }
+    int getMinPos() const { return minPos; }
+    int getMaxPos() const { return maxPos; }
+    // starts an empty window with the zeroed positions [startPos, lastPos]
+    void start(int startPos, int lastPos);
+    // appends zeroed positions up to pos
+    void extendTo(int pos) {
+        if (pos > maxPos) {
+            append(pos);
+        }
+    }
+    // drops the positions below pos, the window is emptied instead of losing
+    // its last position
+    void dropBefore(int pos);
+    void clear() {
+        minPos = -1;
+        maxPos = -1;
+    }
+    // the span counters below pos + 1 become readable, no span may start
+    // below pos + 1 afterwards
+    void sumUpTo(int pos);
+    int getCoverage(int pos) const { return coverage[pos & mask]; }
+    int getLowQualBpsSoft(int pos) const { return lowQualBpsSoft[pos & mask]; }
+    int getLowQualBpsHard(int pos) const { return lowQualBpsHard[pos & mask]; }
+    int getLowQualSpansSoft(int pos) const {
+        return lowQualSpansSoft[pos & mask];
+    }
+    int getLowQualSpansHard(int pos) const {
+        return lowQualSpansHard[pos & mask];
+    }
+    int getNormalBpsHard(int pos) const { return normalBpsHard[pos & mask]; }
+    int getNormalBpsSoft(int pos) const { return normalBpsSoft[pos & mask]; }
+    int getNormalBpsShortIndel(int pos) const {
+        return normalBpsShortIndel[pos & mask];
+    }
+    int getNormalSpans(int pos) const { return normalSpans[pos & mask]; }
+    void incrementLowQualBpsSoft(int pos) { ++lowQualBpsSoft[pos & mask]; }
+    void incrementLowQualBpsHard(int pos) { ++lowQualBpsHard[pos & mask]; }
+    void incrementNormalBpsHard(int pos) { ++normalBpsHard[pos & mask]; }
+    void incrementNormalBpsSoft(int pos) { ++normalBpsSoft[pos & mask]; }
+    void incrementNormalBpsShortIndel(int pos) {
+        ++normalBpsShortIndel[pos & mask];
+    }
+    void decrementLowQualSpansHard(int pos) {
+        removeLowQualSpansHard(pos, pos + 1);
+    }
+    void decrementLowQualSpansSoft(int pos) {
+        removeLowQualSpansSoft(pos, pos + 1);
+    }
+    void decrementNormalSpans(int pos) { removeNormalSpans(pos, pos + 1); }
+    // a normal span over [startPos, endPos) also counts as coverage
+    void addNormalSpans(int startPos, int endPos) {
+        addSpan(coverage, startPos, endPos, 1);
+        addSpan(normalSpans, startPos, endPos, 1);
+    }
+    void addLowQualSpansHard(int startPos, int endPos) {
+        addSpan(lowQualSpansHard, startPos, endPos, 1);
+    }
+    void addLowQualSpansSoft(int startPos, int endPos) {
+        addSpan(lowQualSpansSoft, startPos, endPos, 1);
+    }
+    // the deleted bases [startPos, endPos) of a read
+    void removeNormalSpans(int startPos, int endPos) {
+        addSpan(normalSpans, startPos, endPos, -1);
+    }
+    void removeLowQualSpansHard(int startPos, int endPos) {
+        addSpan(lowQualSpansHard, startPos, endPos, -1);
+    }
+    void removeLowQualSpansSoft(int startPos, int endPos) {
+        addSpan(lowQualSpansSoft, startPos, endPos, -1);
+    }
+
+  private:
+    static constexpr int COUNTERS = 9;
+    static constexpr int SPANCOUNTERS = 4;
+    void addSpan(vector<int> &counter, int startPos, int endPos, int count) {
+        if (startPos < endPos) {
+            counter[startPos & mask] += count;
+            counter[endPos & mask] -= count;
+        }
+    }
+    void append(int pos);
+    void grow(int length);
+    array<vector<int> *, COUNTERS> counters();
+    array<vector<int> *, SPANCOUNTERS> spanCounters();
+    // calls update(from, to) on the at most two index ranges of the ring
+    // that hold the positions [startPos, endPos)
+    template <typename Update>
+    void forIndexRanges(int startPos, int endPos, Update update) const;
+    int mask;
+    int minPos, maxPos;
+    int summedTo;
+    // the span counters at summedTo - 1
+    array<int, SPANCOUNTERS> spanSums;
+    vector<int> coverage;
+    vector<int> normalBpsSoft;
+    vector<int> normalBpsHard;
+    vector<int> normalBpsShortIndel;
+    vector<int> normalSpans;
+    vector<int> lowQualSpansSoft;
+    vector<int> lowQualSpansHard;
+    vector<int> lowQualBpsSoft;
+    vector<int> lowQualBpsHard;
+};
+
+} /* namespace sophia */
+
+#endif /* COVERAGEWINDOW_H_ */
@@ -0,0 +1,183 @@
+/*
+ * CramCodecs.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef CRAMCODECS_H_
+#define CRAMCODECS_H_
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+[[noreturn]] void cramFormatError(const string &reason);
+
+// Cursor over an in-memory byte range of a CRAM container or block
+class CramByteReader {
+  public:
+    CramByteReader() : cursor{nullptr}, end{nullptr} {}
+    CramByteReader(const unsigned char *beginIn, const unsigned char *endIn)
+        : cursor{beginIn}, end{endIn} {}
+    bool atEnd() const { return cursor == end; }
+    unsigned char readByte() {
+        if (cursor == end) {
+            cramFormatError("read past the end of a block");
+        }
+        return *cursor++;
+    }
+    // returns the start of the next length bytes and skips them
+    const unsigned char *readBytes(size_t length) {
+        if (static_cast<size_t>(end - cursor) < length) {
+            cramFormatError("read past the end of a block");
+        }
+        auto start = cursor;
+        cursor += length;
+        return start;
+    }
+    // returns the bytes up to the stop byte and skips them and the stop byte
+    const unsigned char *readUntil(unsigned char stopByte, size_t &length);
+    int32_t readInt32();
+    int32_t readItf8();
+    int64_t readLtf8();
+
+  private:
+    const unsigned char *cursor;
+    const unsigned char *end;
+};
+
+// Most significant bit first reader over the core data block
+class CramBitReader {
+  public:
+    CramBitReader() : cursor{nullptr}, end{nullptr}, bitIndex{7} {}
+    void assign(const unsigned char *beginIn, const unsigned char *endIn) {
+        cursor = beginIn;
+        end = endIn;
+        bitIndex = 7;
+    }
+    int readBit() {
+        if (cursor == end) {
+            cramFormatError("read past the end of the core block");
+        }
+        auto bit = (*cursor >> bitIndex) & 1;
+        if (bitIndex == 0) {
+            bitIndex = 7;
+            ++cursor;
+        } else {
+            --bitIndex;
+        }
+        return bit;
+    }
+    int readBits(int count) {
+        auto value = 0;
+        for (auto i = 0; i < count; ++i) {
+            value = (value << 1) | readBit();
+        }
+        return value;
+    }
+
+  private:
+    const unsigned char *cursor;
+    const unsigned char *end;
+    int bitIndex;
+};
+
+// One block of a container, with its payload already decompressed
+class CramBlock {
+  public:
+    // parses the block at the cursor and advances past it
+    CramBlock(CramByteReader &reader);
+    int getContentType() const { return contentType; }
+    int getContentId() const { return contentId; }
+    const vector<unsigned char> &getData() const { return data; }
+
+  private:
+    void decompress(const unsigned char *compressed, size_t compressedSize,
+                    size_t rawSize);
+    int method;
+    int contentType;
+    int contentId;
+    vector<unsigned char> data;
+};
+
+// The data blocks of one slice: the bit-packed core block and the byte
+// oriented external blocks by content id
+class CramDataStreams {
+  public:
+    CramBitReader core;
+    CramByteReader &external(int contentId) {
+        auto block = externalBlocks.find(contentId);
+        if (block == externalBlocks.end()) {
+            cramFormatError("missing external block " +
+                            to_string(contentId));
+        }
+        return block->second;
+    }
+    unordered_map<int, CramByteReader> externalBlocks;
+};
+
+// Decoder for one data series or tag as described by its codec and codec
+// parameters in the compression header
+class CramEncoding {
+  public:
+    CramEncoding();
+    CramEncoding(CramByteReader &reader);
+    int decodeInt(CramDataStreams &streams) const;
+    unsigned char decodeByte(CramDataStreams &streams) const;
+    // decodes count single bytes, skipping them if out is nullptr
+    void decodeByteRun(CramDataStreams &streams, int count,
+                       unsigned char *out) const;
+    // appends one decoded byte array
+    void decodeByteArray(CramDataStreams &streams,
+                         vector<unsigned char> &out) const;
+
+  private:
+    enum Codec {
+        NULLCODEC = 0,
+        EXTERNAL = 1,
+        HUFFMAN = 3,
+        BYTEARRAYLEN = 4,
+        BYTEARRAYSTOP = 5,
+        BETA = 6,
+        SUBEXP = 7,
+        GAMMA = 9
+    };
+    int decodeBits(CramDataStreams &streams) const;
+    int decodeHuffman(CramBitReader &core) const;
+    int codec;
+    int externalId;
+    int offset;
+    int bitCount;
+    unsigned char stopByte;
+    // canonical huffman code, symbols sorted by code length then value
+    vector<int> huffmanSymbols;
+    vector<int> huffmanFirstCode;
+    vector<int> huffmanFirstIndex;
+    vector<int> huffmanCodeCount;
+    shared_ptr<const CramEncoding> lengthEncoding;
+    shared_ptr<const CramEncoding> valueEncoding;
+};
+
+} /* namespace sophia */
+
+#endif /* CRAMCODECS_H_ */
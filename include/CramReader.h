@@ -0,0 +1,191 @@
+/*
+ * CramReader.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef CRAMREADER_H_
+#define CRAMREADER_H_
+#include "CramCodecs.h"
+#include "RecordReader.h"
+#include "ReferenceFasta.h"
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Sequential reader for CRAM 3.0 files. An I/O thread reads the containers in
+// file order and a pool of worker threads decodes their slices into BAM
+// layout records, which nextRecord() hands out in the original order. With a
+// single thread the slices are decoded inline.
+//
+// Bases and qualities are only reconstructed for event candidates (see
+// BamRecord::isEventCandidate), the records of all other reads carry zeroed
+// SEQ and QUAL and no tags. Containers of unplaced unmapped reads are
+// skipped without decoding.
+class CramReader : public RecordReader {
+  public:
+    CramReader(const string &fileNameIn, const string &referenceFileName,
+               int threadsIn);
+    ~CramReader();
+    CramReader(const CramReader &) = delete;
+    CramReader &operator=(const CramReader &) = delete;
+    bool nextRecord(BamRecord &record) override;
+
+  private:
+    enum DataSeries {
+        BF,
+        CF,
+        RI,
+        RL,
+        AP,
+        RG,
+        RN,
+        MF,
+        NS,
+        NP,
+        TS,
+        NF,
+        TL,
+        FN,
+        FC,
+        FP,
+        DL,
+        BB,
+        QQ,
+        BS,
+        IN,
+        RS,
+        PD,
+        HC,
+        SC,
+        MQ,
+        BA,
+        QS,
+        DATASERIESCOUNT
+    };
+    struct CompressionHeader {
+        bool readNamesIncluded;
+        bool positionDeltas;
+        bool referenceRequired;
+        array<array<char, 4>, 5> substitutions;
+        vector<vector<int>> tagLines;
+        array<CramEncoding, DATASERIESCOUNT> dataSeries;
+        unordered_map<int, CramEncoding> tagEncodings;
+    };
+    struct Slice {
+        shared_ptr<const CompressionHeader> compressionHeader;
+        vector<unsigned char> compressed;
+        vector<char> records;
+        bool ready;
+    };
+    // per record state needed to resolve mates within a slice
+    struct MateLink {
+        size_t recordOffset;
+        int refId;
+        int alignmentStart;
+        int alignmentEnd;
+        int flag;
+        int mateLine;
+        int mateRefId;
+        int matePos;
+        int templateLength;
+        bool templateLengthKnown;
+    };
+    struct ReadFeature {
+        char code;
+        int position;
+        int value;
+        int quality;
+        size_t dataStart;
+        int dataLength;
+    };
+    // decoding state of the slice currently decoded by one worker
+    struct SliceState {
+        const CompressionHeader *header;
+        CramDataStreams streams;
+        int refId;
+        int lastPosition;
+        const CramBlock *embeddedReference;
+        int embeddedReferenceStart;
+        shared_ptr<const string> fastaSequence;
+        int fastaRefId;
+        vector<MateLink> links;
+        vector<ReadFeature> features;
+        vector<unsigned char> featureData;
+        vector<unsigned char> tags;
+        vector<unsigned char> scratch;
+        vector<uint32_t> cigar;
+        string bases;
+        vector<unsigned char> qualities;
+    };
+    void readFileDefinition();
+    void readSamHeader();
+    bool readContainerHeader(int &refId, int &recordCount, int &dataLength,
+                             vector<int> &landmarks);
+    bool readContainer();
+    shared_ptr<const CompressionHeader>
+    parseCompressionHeader(const CramBlock &block) const;
+    Slice *acquireSlice();
+    bool nextSlice();
+    void ioLoop();
+    void workerLoop();
+    void decodeSlice(Slice &slice);
+    void decodeRecord(SliceState &state, int recordIndex, vector<char> &out);
+    void decodeFeatures(SliceState &state);
+    int buildCigar(SliceState &state, int readLength) const;
+    void reconstructBases(SliceState &state, int refId, int position,
+                          int readLength);
+    void checkReferenceMd5(SliceState &state, int start, int span,
+                           const unsigned char *md5);
+    char referenceBase(const SliceState &state, long position) const;
+    static void resolveMates(vector<MateLink> &links);
+    unsigned char readFileByte();
+    int32_t readFileItf8();
+    int64_t readFileLtf8();
+    const string fileName;
+    const int THREADS;
+    FILE *fileHandle;
+    unique_ptr<ReferenceFasta> referenceFasta;
+    vector<unique_ptr<Slice>> slicePool;
+    Slice *currentSlice;
+    size_t currentOffset;
+    mutex queueMutex;
+    condition_variable sliceReady;
+    condition_variable workAvailable;
+    condition_variable slotAvailable;
+    vector<Slice *> freeSlices;
+    deque<Slice *> pendingSlices;
+    deque<Slice *> decodeQueue;
+    bool endOfFile;
+    bool shuttingDown;
+    vector<thread> threadPool;
+};
+
+} /* namespace sophia */
+
+#endif /* CRAMREADER_H_ */
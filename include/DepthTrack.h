@@ -0,0 +1,59 @@
+/*
+ * DepthTrack.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef DEPTHTRACK_H_
+#define DEPTHTRACK_H_
+#include "BgzfWriter.h"
+#include "CoverageWindow.h"
+#include <string>
+
+namespace sophia {
+
+using namespace std;
+
+// Binned depth track written as a bgzipped bedGraph while the coverage
+// window of SamSegmentMapper slides, so the coverage needs no pass over the
+// input of its own. Every bin of binSize bases holds the mean coverage,
+// normal span and low quality span (soft and hard) counts of its bases.
+// Bins without a read are left out, as is usual for bedGraph.
+class DepthTrack {
+  public:
+    DepthTrack(const string &fileName, int binSizeIn);
+    ~DepthTrack() { writeBin(); }
+    // adds the final counters of the positions [startPos, endPos) of window,
+    // which have to follow the positions added before on chrIndex
+    void add(int chrIndex, const CoverageWindow &window, int startPos,
+             int endPos);
+
+  private:
+    void writeBin();
+    const int BINSIZE;
+    BgzfWriter writer;
+    int chrIndex;
+    // the zero based start of the current bin, -1 before the first one
+    int binStart;
+    long coverageSum, normalSpansSum, lowQualSpansSum;
+};
+
+} /* namespace sophia */
+
+#endif /* DEPTHTRACK_H_ */
@@ -23,6 +23,7 @@
 #ifndef HELPERFUNCIONS_H_
 #define HELPERFUNCIONS_H_
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -34,6 +35,15 @@ const int EXITCODE_IOERROR = 1;
 
 istream &error_terminating_getline(istream &is, string &str);
 
+// the splitmix64 finalizer, pseudo random bits for sampling that are the same
+// in every run
+inline uint64_t
+mixBits(uint64_t key) {
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+    return key ^ (key >> 31);
+}
+
 } /* namespace sophia */
 
 #endif /* HELPERFUNCIONS_H_ */
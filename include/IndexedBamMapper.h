@@ -0,0 +1,76 @@
+/*
+ * IndexedBamMapper.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef INDEXEDBAMMAPPER_H_
+#define INDEXEDBAMMAPPER_H_
+#include "BamIndex.h"
+#include "BreakpointOutput.h"
+#include "ReadFilter.h"
+#include "ReadParameters.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Maps the chromosome groups of a coordinate sorted, indexed BAM file on a
+// pool of threads. A group is a run of references that convert to the same
+// ChrConverter index and that a SamSegmentMapper reading the whole file would
+// therefore treat as one chromosome. Every group gets its own BamReader,
+// positioned with the index, and its own mapper. The buffered reports are
+// written in the order of the groups in the file, so the output is the one of
+// the sequential run. Contigs and regions dropped by the read filter are
+// skipped with the index instead of being decompressed.
+class IndexedBamMapper {
+  public:
+    IndexedBamMapper(const string &fileNameIn,
+                     const ReadParameters &readParametersIn, int threadsIn,
+                     const ReadFilter &readFilterIn);
+    ~IndexedBamMapper() = default;
+    void run();
+
+  private:
+    struct ChromosomeGroup {
+        int firstRefId, lastRefId;
+        uint64_t firstOffset;
+        unique_ptr<BreakpointOutput> output;
+        bool done;
+    };
+    void workerLoop();
+    void mapGroup(ChromosomeGroup &group) const;
+    const string fileName;
+    const ReadParameters readParameters;
+    const int THREADS;
+    const ReadFilter readFilter;
+    const BamIndex index;
+    vector<ChromosomeGroup> groups;
+    size_t nextGroup;
+    mutex queueMutex;
+    condition_variable groupDone;
+};
+
+} /* namespace sophia */
+
+#endif /* INDEXEDBAMMAPPER_H_ */
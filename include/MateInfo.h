@@ -26,6 +26,7 @@
 #define MATEINFO_H_
 #include "SuppAlignment.h"
 #include <cmath>
+#include <cstddef>
 
 namespace sophia {
 
@@ -38,10 +39,14 @@ struct MateInfo {
     bool inverted;
     int source;
     int evidenceLevel;
+    // the mates the record stands for, 2^n for one kept at sampling level n
+    // of its MatePool, summed up when records are compressed into clusters
     int matePower;
     int inversionSupport;
     int straightSupport;
-    std::vector<int> bpLocs;
+    // the breakpoints of the read, as a range of the arena of its MatePool
+    size_t bpLocsBegin;
+    size_t bpLocsEnd;
     bool saSupporter;
     bool toRemove;
     bool operator<(const MateInfo &rhs) const {
@@ -69,21 +74,12 @@ struct MateInfo {
     }
     MateInfo(int readStartPosIn, int readEndPosIn, int mateChrIndexIn,
              int mateStartPosIn, int sourceType, bool invertedIn)
-        : readStartPos{readStartPosIn}, readEndPos{readEndPosIn},
-          mateChrIndex{mateChrIndexIn}, mateStartPos{mateStartPosIn},
-          mateEndPos{mateStartPosIn}, inverted{invertedIn}, source{sourceType},
-          evidenceLevel{sourceType == 2 ? 3 : 1}, matePower{1},
-          inversionSupport{invertedIn}, straightSupport{!invertedIn}, bpLocs{},
-          saSupporter{false}, toRemove{false} {}
-    MateInfo(int readStartPosIn, int readEndPosIn, int mateChrIndexIn,
-             int mateStartPosIn, int sourceType, bool invertedIn,
-             const std::vector<int> &bpLocsIn)
         : readStartPos{readStartPosIn}, readEndPos{readEndPosIn},
           mateChrIndex{mateChrIndexIn}, mateStartPos{mateStartPosIn},
           mateEndPos{mateStartPosIn}, inverted{invertedIn}, source{sourceType},
           evidenceLevel{sourceType == 2 ? 3 : 1}, matePower{1},
           inversionSupport{invertedIn}, straightSupport{!invertedIn},
-          bpLocs{bpLocsIn}, saSupporter{false}, toRemove{false} {}
+          bpLocsBegin{0}, bpLocsEnd{0}, saSupporter{false}, toRemove{false} {}
 
     bool isToRemove() const { return toRemove; }
 };
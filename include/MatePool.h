@@ -0,0 +1,204 @@
+/*
+ * MatePool.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef MATEPOOL_H_
+#define MATEPOOL_H_
+#include "HelperFunctions.h"
+#include "MateInfo.h"
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+static_assert(is_trivially_copyable<MateInfo>::value,
+              "MateInfo records are handed out by reference or copied whole");
+
+// The discordant mates of the reads around the current position, in read
+// start order. The records are kept in chunks of fixed capacity, which a
+// breakpoint finalized on another thread can pin instead of copying the
+// records it refers to. Chunks dropped from the front that no one pins any
+// more are reused at the back. The breakpoints of the reads are appended to
+// one arena next to the records, whose ranges are offsets counted from the
+// first breakpoint ever appended, so they stay valid while the front is
+// dropped. Once the pool runs empty, all but a few spare chunks are released,
+// so a deep pileup does not keep its peak size. At sampling level n, only
+// every 2^n-th mate offered is kept on average, picked by its read start and
+// offer count the same way in every run, and it stands for 2^n mates in the
+// counts. Thinning keeps the pool in read start order, which a reservoir
+// replacing older mates would not.
+class MatePool {
+  public:
+    using Chunk = vector<MateInfo>;
+    MatePool()
+        : chunks{}, spareChunks{}, frontIndex{0}, mateCount{0}, bpLocs{},
+          droppedBpLocs{0}, samplingLevel{0}, offeredMates{0} {}
+    bool empty() const { return mateCount == 0; }
+    size_t size() const { return mateCount; }
+    const MateInfo &operator[](size_t index) const {
+        index += frontIndex;
+        return (*chunks[index / CHUNKSIZE])[index % CHUNKSIZE];
+    }
+    const MateInfo &front() const { return (*chunks.front())[frontIndex]; }
+    void emplace_back(int readStartPos, int readEndPos, int mateChrIndex,
+                      int mateStartPos, int sourceType, bool inverted) {
+        if (isSampledOut(readStartPos)) {
+            return;
+        }
+        addMate(readStartPos, readEndPos, mateChrIndex, mateStartPos,
+                sourceType, inverted);
+    }
+    void emplace_back(int readStartPos, int readEndPos, int mateChrIndex,
+                      int mateStartPos, int sourceType, bool inverted,
+                      const vector<int> &readBreakpoints) {
+        if (isSampledOut(readStartPos)) {
+            return;
+        }
+        addMate(readStartPos, readEndPos, mateChrIndex, mateStartPos,
+                sourceType, inverted);
+        bpLocs.insert(bpLocs.end(), readBreakpoints.cbegin(),
+                      readBreakpoints.cend());
+        chunks.back()->back().bpLocsEnd = droppedBpLocs + bpLocs.size();
+    }
+    void setSamplingLevel(int samplingLevelIn) {
+        samplingLevel = samplingLevelIn;
+    }
+    void pop_front() {
+        --mateCount;
+        if (++frontIndex == CHUNKSIZE) {
+            spareChunks.push_back(move(chunks.front()));
+            chunks.pop_front();
+            frontIndex = 0;
+        }
+        auto keptFrom = empty() ? droppedBpLocs + bpLocs.size()
+                                : front().bpLocsBegin;
+        bpLocs.erase(bpLocs.begin(),
+                     bpLocs.begin() + (keptFrom - droppedBpLocs));
+        droppedBpLocs = keptFrom;
+        if (empty()) {
+            trimSpareChunks();
+        }
+    }
+    // the mates are picked afresh after clear, so the sampling of a
+    // chromosome does not depend on the chromosomes before
+    void clear() {
+        for (auto &chunk : chunks) {
+            spareChunks.push_back(move(chunk));
+        }
+        chunks.clear();
+        frontIndex = 0;
+        mateCount = 0;
+        droppedBpLocs += bpLocs.size();
+        bpLocs.clear();
+        offeredMates = 0;
+        trimSpareChunks();
+    }
+    // whether the read of mateInfo, which has to be in this pool, breaks at
+    // pos
+    bool hasBpLoc(const MateInfo &mateInfo, int pos) const {
+        for (auto i = mateInfo.bpLocsBegin; i != mateInfo.bpLocsEnd; ++i) {
+            if (bpLocs[i - droppedBpLocs] == pos) {
+                return true;
+            }
+        }
+        return false;
+    }
+    // keeps the records of the pool alive in pinned, until it is destroyed
+    void pinChunks(vector<shared_ptr<const Chunk>> &pinned) const {
+        pinned.insert(pinned.end(), chunks.cbegin(), chunks.cend());
+    }
+
+  private:
+    static const size_t CHUNKSIZE = 1024;
+    // the spare chunks kept once the pool is empty
+    static const size_t KEPTSPARECHUNKS = 4;
+    bool isSampledOut(int readStartPos) {
+        ++offeredMates;
+        return samplingLevel != 0 &&
+               (mixBits(static_cast<uint64_t>(readStartPos) << 32 |
+                        offeredMates) &
+                ((1ull << samplingLevel) - 1)) != 0;
+    }
+    void addMate(int readStartPos, int readEndPos, int mateChrIndex,
+                 int mateStartPos, int sourceType, bool inverted) {
+        if (chunks.empty() || chunks.back()->size() == CHUNKSIZE) {
+            chunks.push_back(takeFreeChunk());
+        }
+        chunks.back()->emplace_back(readStartPos, readEndPos, mateChrIndex,
+                                    mateStartPos, sourceType, inverted);
+        ++mateCount;
+        auto &mate = chunks.back()->back();
+        mate.bpLocsBegin = droppedBpLocs + bpLocs.size();
+        mate.bpLocsEnd = mate.bpLocsBegin;
+        mate.matePower = 1 << samplingLevel;
+        mate.inversionSupport = inverted ? mate.matePower : 0;
+        mate.straightSupport = inverted ? 0 : mate.matePower;
+    }
+    // the breakpoints pinning chunks are finalized on other threads, but they
+    // are destroyed on the thread of the pool
+    shared_ptr<Chunk> takeFreeChunk() {
+        for (auto it = spareChunks.begin(); it != spareChunks.end(); ++it) {
+            if (it->use_count() == 1) {
+                auto freeChunk = move(*it);
+                spareChunks.erase(it);
+                freeChunk->clear();
+                return freeChunk;
+            }
+        }
+        auto chunk = make_shared<Chunk>();
+        chunk->reserve(CHUNKSIZE);
+        return chunk;
+    }
+    // a chunk still pinned is freed by the last breakpoint releasing it
+    void trimSpareChunks() {
+        if (spareChunks.size() > KEPTSPARECHUNKS) {
+            spareChunks.erase(spareChunks.begin() + KEPTSPARECHUNKS,
+                              spareChunks.end());
+            spareChunks.shrink_to_fit();
+        }
+    }
+    // the records from frontIndex of the first chunk on, no chunk is ever
+    // filled beyond its reserved capacity, so the records do not move
+    deque<shared_ptr<Chunk>> chunks;
+    vector<shared_ptr<Chunk>> spareChunks;
+    size_t frontIndex;
+    size_t mateCount;
+    deque<int> bpLocs;
+    size_t droppedBpLocs;
+    int samplingLevel;
+    uint64_t offeredMates;
+};
+
+// A mate of a MatePool as one breakpoint sees it, with the fields the
+// breakpoint sets for itself
+struct MateInfoRef {
+    const MateInfo *mateInfo;
+    bool bpPosMatch;
+    bool saSupporter;
+};
+
+} /* namespace sophia */
+
+#endif /* MATEPOOL_H_ */
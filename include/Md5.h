@@ -0,0 +1,37 @@
+/*
+ * Md5.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef MD5_H_
+#define MD5_H_
+#include <array>
+#include <cstddef>
+
+namespace sophia {
+
+using namespace std;
+
+// The RFC 1321 MD5 digest, used to match the reference MD5 stored in CRAM
+// slice headers against the bases of the --reference FASTA.
+array<unsigned char, 16> md5Digest(const char *data, size_t length);
+
+} /* namespace sophia */
+
+#endif /* MD5_H_ */
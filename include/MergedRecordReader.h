@@ -0,0 +1,99 @@
+/*
+ * MergedRecordReader.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef MERGEDRECORDREADER_H_
+#define MERGEDRECORDREADER_H_
+#include "RecordReader.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Merges coordinate sorted inputs with the same references into one stream,
+// in the order samtools merge writes them: by reference, position and strand,
+// ties in the order of the inputs. Every input is read ahead on its own thread
+// into chunks of copied records, and nextRecord() takes the smallest of the
+// next records of all inputs off a heap.
+class MergedRecordReader : public RecordReader {
+  public:
+    MergedRecordReader(vector<unique_ptr<RecordReader>> inputsIn);
+    ~MergedRecordReader() override;
+    MergedRecordReader(const MergedRecordReader &) = delete;
+    MergedRecordReader &operator=(const MergedRecordReader &) = delete;
+    bool nextRecord(BamRecord &record) override;
+
+  private:
+    static constexpr size_t CHUNKSIZE = 4096;
+    // one chunk is held by the merge, the rest may be queued or filling
+    static constexpr int CHUNKSPERINPUT = 3;
+    struct Chunk {
+        vector<char> recordData;
+        vector<int> recordStarts;
+        vector<int> recordChrIndices;
+        vector<int> recordMateChrIndices;
+    };
+    struct Source {
+        unique_ptr<RecordReader> reader;
+        vector<unique_ptr<Chunk>> chunkPool;
+        vector<Chunk *> freeChunks;
+        deque<Chunk *> filledChunks;
+        bool endOfInput;
+        // only touched by the merging thread
+        Chunk *currentChunk;
+        size_t currentIndex;
+        // the record of this input that is next in line
+        BamRecord front;
+    };
+    struct HeapEntry {
+        uint64_t key;
+        int source;
+        bool operator>(const HeapEntry &rhs) const {
+            return key > rhs.key || (key == rhs.key && source > rhs.source);
+        }
+    };
+    static uint64_t sortKey(const BamRecord &record);
+    void readLoop(Source &source);
+    // moves on to the next record of source, false at its end
+    bool advance(Source &source);
+    vector<Source> sources;
+    priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry>> heap;
+    // whose record was handed out last, -1 before the first
+    int lastSource;
+    mutex queueMutex;
+    condition_variable chunkReady;
+    condition_variable slotAvailable;
+    bool shuttingDown;
+    vector<thread> threadPool;
+};
+
+} /* namespace sophia */
+
+#endif /* MERGEDRECORDREADER_H_ */
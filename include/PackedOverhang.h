@@ -0,0 +1,63 @@
+/*
+ * PackedOverhang.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+
+#ifndef PACKEDOVERHANG_H_
+#define PACKEDOVERHANG_H_
+#include "Alignment.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// The overhang of a soft clipped read at its chosen breakpoint, read from
+// the breakpoint outwards, so that overhangs on the same side of a
+// breakpoint are compared from their first base on. The bases are packed
+// into words of 64 bases each: one word for each bit of the 2 bit base code
+// and one marking the N bases, which match any base. Overhangs with other
+// characters than ACGTN keep their bases and are compared one by one.
+class PackedOverhang {
+  public:
+    explicit PackedOverhang(const Alignment &alignment);
+    bool isEncounteredM() const { return encounteredM; }
+    int getLength() const { return length; }
+    // the mismatches of shorter against the first bases of this overhang,
+    // leaving out the N bases of both. Counting stops above limit.
+    int countMismatches(const PackedOverhang &shorter, int limit) const;
+
+  private:
+    static const int WORDBASES = 64;
+    char getBase(int i) const;
+    // the low and high code bits and the N mask of a word, in a row
+    static const int PLANES = 3;
+    bool encounteredM;
+    int length;
+    vector<uint64_t> planes;
+    string otherBases;
+};
+
+} /* namespace sophia */
+
+#endif /* PACKEDOVERHANG_H_ */
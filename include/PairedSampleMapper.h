@@ -0,0 +1,67 @@
+/*
+ * PairedSampleMapper.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef PAIREDSAMPLEMAPPER_H_
+#define PAIREDSAMPLEMAPPER_H_
+#include "BreakpointOutput.h"
+#include "ReadBatchPipeline.h"
+#include "SamSegmentMapper.h"
+#include <utility>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Maps a tumour and a control sample in one run. Both inputs are read on their
+// own threads and classified by one shared pool of worker threads. Their
+// batches go to two independent SamSegmentMappers in lockstep by genomic
+// position, so that both work on the same stretch of the genome. Each sample
+// is classified with its own ReadParameters. Each output is the one of a
+// separate run on its sample, and so are the depth tracks and window budgets
+// unless they are nullptr.
+class PairedSampleMapper {
+  public:
+    PairedSampleMapper(const ReadParameters &tumourReadParametersIn,
+                       const ReadParameters &controlReadParametersIn,
+                       int threadsIn, BreakpointOutput &tumourOutputIn,
+                       BreakpointOutput &controlOutputIn,
+                       DepthTrack *tumourDepthTrackIn,
+                       DepthTrack *controlDepthTrackIn,
+                       WindowBudget *tumourWindowBudgetIn,
+                       WindowBudget *controlWindowBudgetIn);
+    void run(const ReadBatchPipeline::BatchFiller &fillTumour,
+             const ReadBatchPipeline::BatchFiller &fillControl);
+
+  private:
+    // the chromosomes are ranked in the order the inputs reach them, as
+    // their order in the input need not follow the ChrConverter indices
+    pair<int, int> batchPosition(const ReadBatch &batch);
+    const int THREADS;
+    SamSegmentMapper tumourMapper, controlMapper;
+    vector<int> chromosomeRanks;
+    int rankedChromosomes;
+};
+
+} /* namespace sophia */
+
+#endif /* PAIREDSAMPLEMAPPER_H_ */
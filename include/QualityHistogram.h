@@ -0,0 +1,46 @@
+/*
+ * QualityHistogram.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef QUALITYHISTOGRAM_H_
+#define QUALITYHISTOGRAM_H_
+
+namespace sophia {
+
+using namespace std;
+
+// Median base quality of a quality string range, computed from a counting
+// histogram on the stack. The low quality runs are found 16 bases at a time
+// with SSE2 on x86-64 and with a scalar loop elsewhere.
+class QualityHistogram {
+  public:
+    // the median of the qualities in [begin, end), or -1 if the range is
+    // empty or contains more than five consecutive qualities below
+    // lowThreshold. The order of the range does not matter, so forward and
+    // reverse overhangs are both passed front to back.
+    static double median(const char *begin, const char *end, int lowThreshold);
+
+  private:
+    static const int MAXLOWRUN = 5;
+};
+
+} /* namespace sophia */
+
+#endif /* QUALITYHISTOGRAM_H_ */
@@ -0,0 +1,95 @@
+/*
+ * ReadBatch.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef READBATCH_H_
+#define READBATCH_H_
+#include "Alignment.h"
+#include "BamRecord.h"
+#include "CompactAlignment.h"
+#include "ReadFilter.h"
+#include "ReadParameters.h"
+#include "RecordReader.h"
+#include "SamLineReader.h"
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// A run of consecutive reads of the input. Classifying a read only depends
+// on the read itself, the static thresholds and the ReadParameters of its
+// sample, so a batch can be classified on a worker thread while the
+// SamSegmentMapper consumes the batches before it in input order.
+class ReadBatch {
+  public:
+    struct ClassifiedRead {
+        CompactAlignment read;
+        // only set for event candidates
+        shared_ptr<Alignment> alignment;
+    };
+    ReadBatch(const ReadParameters &readParametersIn);
+    // false once the input is exhausted. Reads failing the filter are
+    // dropped before they are stored.
+    bool fill(SamLineReader &lineReader, ReadFilter &readFilter);
+    bool fill(RecordReader &recordReader, ReadFilter &readFilter);
+    void classify();
+    const vector<ClassifiedRead> &getReads() const { return reads; }
+    // the offset of the input the read getReads()[readIndex] was read from,
+    // RecordReader::NOOFFSET for SAM input
+    uint64_t getInputOffset(size_t readIndex) const {
+        return recordOffsets.empty() ? RecordReader::NOOFFSET
+                                     : recordOffsets[readIndex];
+    }
+    // drops the input and the classified reads once they are consumed
+    void release();
+
+  private:
+    static const int CAPACITY = 4096;
+    // free pool entries looked at before a new Alignment is allocated
+    static const int POOLSCANLIMIT = 64;
+    shared_ptr<Alignment> takeFreeAlignment();
+    // looks at FLAG, RNAME and POS only
+    static bool passesFilter(string_view line, ReadFilter &readFilter);
+    void classifyLine(string_view line,
+                      const shared_ptr<const vector<char>> &lineBlock);
+    void classifyRecord(const BamRecord &record);
+    const ReadParameters &readParameters;
+    // SAM input: the lines and the blocks of the SamLineReader they view
+    vector<string_view> lines;
+    vector<shared_ptr<const vector<char>>> lineBlocks;
+    // BAM and CRAM input: copies of the records passing the default filter
+    vector<char> recordData;
+    vector<int> recordStarts;
+    vector<int> recordChrIndices, recordMateChrIndices;
+    vector<uint64_t> recordOffsets;
+    vector<int> fieldTabs;
+    vector<ClassifiedRead> reads;
+    // the Alignments of this batch's event candidates. An entry is free
+    // again once the breakpoints supported by its read are printed.
+    vector<shared_ptr<Alignment>> alignmentPool;
+    size_t alignmentPoolCursor;
+};
+
+} /* namespace sophia */
+
+#endif /* READBATCH_H_ */
@@ -0,0 +1,88 @@
+/*
+ * ReadBatchPipeline.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef READBATCHPIPELINE_H_
+#define READBATCHPIPELINE_H_
+#include "ReadBatch.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Fills ReadBatches from one or more inputs and classifies them. With more
+// than one thread, every input is read on its own thread into its own pool of
+// batches, a pool of worker threads shared by all inputs classifies them and
+// next() hands out the batches of an input in input order. The reads of an
+// input are classified with its entry of readParametersIn. With a single
+// thread the batches are filled and classified inline by next().
+class ReadBatchPipeline {
+  public:
+    using BatchFiller = function<bool(ReadBatch &)>;
+    ReadBatchPipeline(const vector<BatchFiller> &fillersIn,
+                      const vector<const ReadParameters *> &readParametersIn,
+                      int threadsIn);
+    ~ReadBatchPipeline();
+    ReadBatchPipeline(const ReadBatchPipeline &) = delete;
+    ReadBatchPipeline &operator=(const ReadBatchPipeline &) = delete;
+    // the next classified batch of an input, nullptr at its end. The batch
+    // stays valid until the next call for the same input.
+    const ReadBatch *next(int input);
+
+  private:
+    struct BatchSlot {
+        BatchSlot(const ReadParameters &readParameters)
+            : batch{readParameters}, ready{false} {}
+        ReadBatch batch;
+        bool ready;
+    };
+    struct Input {
+        BatchFiller fill;
+        vector<unique_ptr<BatchSlot>> batchPool;
+        vector<BatchSlot *> freeBatches;
+        deque<BatchSlot *> pendingBatches;
+        bool endOfInput{false};
+        // the batch handed out last, only touched by the consuming thread
+        BatchSlot *currentBatch{nullptr};
+    };
+    void readerLoop(Input &input);
+    void workerLoop();
+    const int THREADS;
+    vector<Input> inputs;
+    mutex queueMutex;
+    condition_variable batchReady;
+    condition_variable workAvailable;
+    condition_variable slotAvailable;
+    deque<BatchSlot *> classifyQueue;
+    bool shuttingDown;
+    vector<thread> threadPool;
+};
+
+} /* namespace sophia */
+
+#endif /* READBATCHPIPELINE_H_ */
@@ -0,0 +1,70 @@
+/*
+ * ReadCalibrator.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef READCALIBRATOR_H_
+#define READCALIBRATOR_H_
+#include "ReplayRecordReader.h"
+#include "SamLineReader.h"
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Estimates the read length and the insert size distribution from the first
+// properly paired reads of the input, for runs that are not given them. The
+// readers hand the reads looked at out again, so the estimate costs no
+// separate pass over the input.
+class ReadCalibrator {
+  public:
+    ReadCalibrator(int pairCountIn);
+    void calibrate(SamLineReader &lineReader);
+    void calibrate(ReplayRecordReader &recordReader);
+    // the most frequent length of the primary reads, 0 without any
+    int getReadLength() const { return readLength; }
+    // false if there were too few proper pairs for an estimate
+    bool hasIsizes() const {
+        return static_cast<int>(isizes.size()) >= MINPAIRCOUNT;
+    }
+    double getMedianIsize() const { return medianIsize; }
+    // the median absolute deviation of the insert sizes, scaled to the
+    // standard deviation of a normal distribution
+    double getIsizeStd() const { return isizeStd; }
+
+  private:
+    static constexpr int MINPAIRCOUNT = 100;
+    // false once enough pairs have been seen
+    bool addRead(int flag, int templateLength, int sequenceLength);
+    void estimate();
+    const int PAIRCOUNT;
+    // the number of reads looked at for them at most
+    const int READLIMIT;
+    int readCount;
+    vector<int> isizes;
+    vector<int> readLengthCounts;
+    int readLength;
+    double medianIsize, isizeStd;
+};
+
+} /* namespace sophia */
+
+#endif /* READCALIBRATOR_H_ */
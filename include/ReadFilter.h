@@ -0,0 +1,87 @@
+/*
+ * ReadFilter.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef READFILTER_H_
+#define READFILTER_H_
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Selects the reads to map by their raw FLAG, reference name and 0-based
+// leftmost position, before any parsing beyond these fields. Flags work like
+// the -f and -F options of samtools view. Contigs can be excluded by name, and
+// regions included or excluded with BED files, where a read belongs to the
+// region containing its position. Keeps the contig of the last lookup, so
+// every reading thread needs its own copy.
+class ReadFilter {
+  public:
+    ReadFilter();
+    void setFlags(int requiredFlagsIn, int excludedFlagsIn);
+    // a comma separated list of reference names
+    void excludeContigs(const string &contigList);
+    void addRegions(const string &bedFileName, bool include);
+    bool passesFlags(int flag) const {
+        return (flag & requiredFlags) == requiredFlags &&
+               (flag & excludedFlags) == 0;
+    }
+    // whether contigs or regions are filtered
+    bool filtersPositions() const { return !contigs.empty() || includeOnly; }
+    bool isActive() const {
+        return requiredFlags != 0 || excludedFlags != 0 || filtersPositions();
+    }
+    bool passesPosition(string_view contig, int pos) {
+        return nextPassingPosition(contig, pos) == pos;
+    }
+    // pos if a read there passes, otherwise the first position after pos
+    // where one may pass, or INT_MAX if none on this contig does
+    int nextPassingPosition(string_view contig, int pos);
+
+  private:
+    struct ContigRegions {
+        string name;
+        bool excluded;
+        // sorted, merged, half-open intervals
+        vector<pair<int, int>> includes, excludes;
+    };
+    ContigRegions &addContig(const string &name);
+    const ContigRegions &lookUp(string_view contig);
+    static void mergeIntervals(vector<pair<int, int>> &intervals);
+    int requiredFlags, excludedFlags;
+    // with an include BED, only the listed regions pass
+    bool includeOnly;
+    vector<ContigRegions> contigs;
+    unordered_map<string, int> contigIndices;
+    // the regions of contigs that no filter mentions
+    const ContigRegions unlisted;
+    // the contig of the last lookup and its index in contigs, -1 if unlisted
+    string lastContig;
+    int lastContigIndex;
+};
+
+} /* namespace sophia */
+
+#endif /* READFILTER_H_ */
@@ -0,0 +1,50 @@
+/*
+ * ReadParameters.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef READPARAMETERS_H_
+#define READPARAMETERS_H_
+#include <cmath>
+
+namespace sophia {
+
+using namespace std;
+
+// The thresholds derived from the default read length and the insert size
+// distribution of a sample. Every SamSegmentMapper holds those of its own
+// sample, so a tumour and its control can be mapped with different ones in
+// the same run.
+struct ReadParameters {
+    ReadParameters(int defaultReadLengthIn, double isizeMaxIn)
+        : defaultReadLength{defaultReadLengthIn}, isizeMax{isizeMaxIn},
+          discordantLowQualLeftRange{
+              static_cast<int>(round(defaultReadLengthIn * 1.11))},
+          discordantLowQualRightRange{
+              static_cast<int>(round(defaultReadLengthIn * 0.51))} {}
+    int defaultReadLength;
+    // the smallest insert size of a distant mate
+    double isizeMax;
+    int discordantLowQualLeftRange;
+    int discordantLowQualRightRange;
+};
+
+} /* namespace sophia */
+
+#endif /* READPARAMETERS_H_ */
@@ -0,0 +1,58 @@
+/*
+ * RecordReader.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef RECORDREADER_H_
+#define RECORDREADER_H_
+#include "BamRecord.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Common interface of the binary alignment inputs. Records are handed out in
+// the BAM layout, together with the ChrConverter indices of their reference
+// and mate reference.
+class RecordReader {
+  public:
+    // tell() of the inputs without file offsets to resume from
+    static const uint64_t NOOFFSET = UINT64_MAX;
+    virtual ~RecordReader() = default;
+    // the record stays valid until the next call
+    virtual bool nextRecord(BamRecord &record) = 0;
+    // the offset the next record is read from
+    virtual uint64_t tell() const { return NOOFFSET; }
+    const vector<string> &getReferenceNames() const { return referenceNames; }
+    int toChrIndex(int refId) const;
+
+  protected:
+    void addReference(const string &name);
+
+  private:
+    vector<string> referenceNames;
+    vector<int> referenceChrIndices;
+};
+
+} /* namespace sophia */
+
+#endif /* RECORDREADER_H_ */
@@ -0,0 +1,63 @@
+/*
+ * ReferenceFasta.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef REFERENCEFASTA_H_
+#define REFERENCEFASTA_H_
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Random access to the sequences of a local FASTA file through its samtools
+// faidx index (the index is built in memory if there is no .fai file). The
+// most recently used sequences are kept in memory, upper-cased.
+class ReferenceFasta {
+  public:
+    ReferenceFasta(const string &fileNameIn);
+    // thread safe, the returned sequence stays valid while it is held
+    shared_ptr<const string> getSequence(const string &name);
+
+  private:
+    struct IndexEntry {
+        long length;
+        long offset;
+        long lineBases;
+        long lineWidth;
+    };
+    static const int CACHEDSEQUENCES = 2;
+    bool readIndex();
+    void buildIndex();
+    shared_ptr<const string> loadSequence(const IndexEntry &entry);
+    const string fileName;
+    unordered_map<string, IndexEntry> index;
+    mutex cacheMutex;
+    vector<pair<string, shared_ptr<const string>>> cache;
+};
+
+} /* namespace sophia */
+
+#endif /* REFERENCEFASTA_H_ */
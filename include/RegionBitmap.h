@@ -0,0 +1,60 @@
+/*
+ * RegionBitmap.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef REGIONBITMAP_H_
+#define REGIONBITMAP_H_
+#include <string>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Regions of the genome at a resolution of BINSIZE bases, one bit per bin
+// and ChrConverter index, so a position is looked up in constant time. The
+// regions are rounded out to whole bins.
+class RegionBitmap {
+  public:
+    static const int BINSIZE = 10000;
+    RegionBitmap() : bins{} {}
+    // the one based positions [startPos, endPos]
+    void add(int chrIndex, int startPos, int endPos);
+    // adds the regions of a BED file, whose contig names are converted like
+    // those of the reads
+    void addBed(const string &bedFileName);
+    bool contains(int chrIndex, int pos) const {
+        if (chrIndex < 0 || chrIndex >= static_cast<int>(bins.size())) {
+            return false;
+        }
+        const auto &chrBins = bins[chrIndex];
+        auto bin = pos / BINSIZE;
+        return bin >= 0 && bin < static_cast<int>(chrBins.size()) &&
+               chrBins[bin];
+    }
+
+  private:
+    vector<vector<bool>> bins;
+};
+
+} /* namespace sophia */
+
+#endif /* REGIONBITMAP_H_ */
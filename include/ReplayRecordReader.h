@@ -0,0 +1,59 @@
+/*
+ * ReplayRecordReader.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef REPLAYRECORDREADER_H_
+#define REPLAYRECORDREADER_H_
+#include "RecordReader.h"
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Hands out the records of another reader. The records read between mark and
+// rewind are copied and handed out once more after rewind, the copies are
+// released once they have all been handed out again.
+class ReplayRecordReader : public RecordReader {
+  public:
+    ReplayRecordReader(RecordReader &inputIn);
+    bool nextRecord(BamRecord &record) override;
+    uint64_t tell() const override;
+    // keeps the records from the next one on until rewind
+    void mark();
+    // hands out the records read since mark again
+    void rewind();
+
+  private:
+    RecordReader &input;
+    bool marked;
+    size_t replayed;
+    vector<char> recordData;
+    // offsets into recordData, which passes 2 GB on deep regions
+    vector<size_t> recordStarts;
+    vector<int> recordChrIndices;
+    vector<int> recordMateChrIndices;
+    vector<uint64_t> recordOffsets;
+};
+
+} /* namespace sophia */
+
+#endif /* REPLAYRECORDREADER_H_ */
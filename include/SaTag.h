@@ -0,0 +1,54 @@
+/*
+ * SaTag.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef SATAG_H_
+#define SATAG_H_
+#include <string_view>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// One alignment of an SA tag, "chr,pos,strand,CIGAR,mapq,NM", reduced to the
+// fields the supplementary alignments of a breakpoint are built from
+struct SaEntry {
+    int chrIndex;
+    int pos;
+    char strand;
+    // the start of the largest clip on the read if it follows an M, which
+    // moves pos from the start of the alignment to its breakpoint
+    int clipOffset;
+    int mapq;
+};
+
+// Decodes the value of an SA tag in a single pass over its bytes
+class SaTag {
+  public:
+    // replaces entries with the alignments of value, which lacks the ';'
+    // that ends the tag
+    static void decode(string_view value, vector<SaEntry> &entries);
+};
+
+} /* namespace sophia */
+
+#endif /* SATAG_H_ */
@@ -0,0 +1,67 @@
+/*
+ * SamLineReader.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef SAMLINEREADER_H_
+#define SAMLINEREADER_H_
+#include <cstdio>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Reads SAM text in large blocks and hands out the lines as views into the
+// current block. A line stays valid for as long as its block is held, so an
+// Alignment that is kept beyond the next line pins the block instead of
+// copying the line. Blocks that are no longer held by anyone are reused.
+// Lines can be read ahead between mark and rewind, they are kept in the block
+// and handed out once more after rewind.
+class SamLineReader {
+  public:
+    SamLineReader(FILE *inputIn);
+    // false at the end of the input
+    bool nextLine(string_view &line);
+    // keeps the lines from the next one on until rewind
+    void mark();
+    // hands out the lines read since mark again
+    void rewind();
+    // the block of the line last handed out
+    shared_ptr<const vector<char>> getBlock() const { return block; }
+
+  private:
+    static constexpr size_t BLOCKSIZE = 8 << 20;
+    void refill();
+    shared_ptr<vector<char>> takeFreeBlock();
+    FILE *input;
+    shared_ptr<vector<char>> block;
+    vector<shared_ptr<vector<char>>> spareBlocks;
+    size_t cursor;
+    size_t filled;
+    size_t markedCursor;
+    bool marked;
+    bool endOfInput;
+};
+
+} /* namespace sophia */
+
+#endif /* SAMLINEREADER_H_ */
@@ -25,11 +25,24 @@
 #ifndef SAMSEGMENTMAPPER_H_
 #define SAMSEGMENTMAPPER_H_
 #include "Breakpoint.h"
-#include "CoverageAtBase.h"
-#include "MateInfo.h"
+#include "BreakpointFinalizer.h"
+#include "BreakpointOutput.h"
+#include "BreakpointWindow.h"
+#include "Checkpoint.h"
+#include "CompactAlignment.h"
+#include "CoverageWindow.h"
+#include "DepthTrack.h"
+#include "MatePool.h"
+#include "ReadBatch.h"
+#include "ReadBatchPipeline.h"
+#include "ReadFilter.h"
+#include "ReadParameters.h"
+#include "RecordReader.h"
+#include "RegionBitmap.h"
+#include "SamLineReader.h"
+#include "WindowBudget.h"
 #include <ctime>
 #include <fstream>
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -38,29 +51,72 @@ namespace sophia {
 
 using namespace std;
 
+// Reads the input in batches, which a ReadBatchPipeline fills and classifies
+// on threadsIn threads. The batches are consumed in input order on the calling
+// thread, so the output does not depend on the thread count. The breakpoints
+// are finalized by a BreakpointFinalizer on as many threads. The reads are
+// classified with readParametersIn, those of the sample mapped. The positions
+// leaving the coverage window go to depthTrackIn, windowBudgetIn bounds the
+// evidence kept by the window, and checkpointIn is saved at the start of
+// every chromosome after the first, unless they are nullptr.
 class SamSegmentMapper {
   public:
-    SamSegmentMapper(int defaultReadLengthIn);
+    SamSegmentMapper(const ReadParameters &readParametersIn, int threadsIn,
+                     BreakpointOutput &outputIn, DepthTrack *depthTrackIn,
+                     WindowBudget *windowBudgetIn, Checkpoint *checkpointIn);
     ~SamSegmentMapper() = default;
-    void parseSamStream();
+    const ReadParameters &getReadParameters() const { return readParameters; }
+    void parseSamStream(SamLineReader &lineReader, ReadFilter &readFilter);
+    void parseRecordStream(RecordReader &recordReader,
+                           ReadFilter &readFilter);
+    void parseBatches(const ReadBatchPipeline::BatchFiller &fill);
+    // for callers that run the pipeline themselves: the batches in input
+    // order, then finish() at the end of the input
+    void consumeBatch(const ReadBatch &batch);
+    void finish();
+    // the regions whose reads are no discordant mates, by default the hg19
+    // region chr2:33140000-33149999
+    static RegionBitmap MATEBLACKLIST;
 
   private:
     void printBps(int alignmentStart);
-    void switchChromosome(const Alignment &alignment);
-    void incrementCoverages(const Alignment &alignment);
-    void assignBps(shared_ptr<Alignment> &alignment);
+    void switchChromosome(int chrIndex);
+    // once the reports of the chromosomes before are written out
+    void saveCheckpoint(int lastChrIndex, uint64_t inputOffset);
+    // the positions of the coverage window below pos, before it drops them
+    void trackDepth(int pos);
+    // samples the evidence added from pos on if the window is over budget
+    void checkWindowBudget(int pos);
+    // the read spans and the discordant mate pools, for all reads
+    void incrementCoverages(const CompactAlignment &alignment,
+                            const vector<int> &readBreakpoints);
+    // the clips and indels of event candidates
+    void incrementBreakpointCoverages(const Alignment &alignment);
+    void assignBps(const shared_ptr<Alignment> &alignment);
     const time_t STARTTIME;
+    const int THREADS;
+    BreakpointOutput &output;
+    DepthTrack *const depthTrack;
+    WindowBudget *const windowBudget;
+    Checkpoint *const checkpoint;
+    // the open breakpoints point to these
+    const ReadParameters readParameters;
     const bool PROPERPARIRCOMPENSATIONMODE;
     const int DISCORDANTLEFTRANGE;
     const int DISCORDANTRIGHTRANGE;
     unsigned int printedBps;
     int chrIndexCurrent;
-    int minPos, maxPos;
-    map<int, Breakpoint> breakpointsCurrent;
-    deque<CoverageAtBase> coverageProfiles;
-    deque<MateInfo> discordantAlignmentsPool;
-    deque<MateInfo> discordantAlignmentCandidatesPool;
-    deque<MateInfo> discordantLowQualAlignmentsPool;
+    // the breakpoints below this position have their coverages set
+    int coverageFrontier;
+    BreakpointWindow breakpointsCurrent;
+    // the clipped reads held by the open breakpoints
+    long retainedAlignments;
+    bool samplingEvidence;
+    CoverageWindow coverageProfiles;
+    MatePool discordantAlignmentsPool;
+    MatePool discordantAlignmentCandidatesPool;
+    MatePool discordantLowQualAlignmentsPool;
+    BreakpointFinalizer finalizer;
 };
 
 } /* namespace sophia */
@@ -0,0 +1,56 @@
+/*
+ * SamTokenizer.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#ifndef SAMTOKENIZER_H_
+#define SAMTOKENIZER_H_
+#include <vector>
+
+namespace sophia {
+
+using namespace std;
+
+// Finds the tab positions of SAM lines 16 or 32 bytes at a time. The AVX2
+// version is picked at runtime if the CPU supports it, SSE2 is the x86-64
+// baseline and other architectures use the scalar loop.
+class SamTokenizer {
+  public:
+    using TabScanner = int (*)(const char *line, int from, int length,
+                               int maxTabs, vector<int> &positions);
+    // appends the positions of the first maxTabs tabs in line[from, length)
+    // to positions and returns how many were found
+    static int findTabs(const char *line, int from, int length, int maxTabs,
+                        vector<int> &positions) {
+        return SCANNER(line, from, length, maxTabs, positions);
+    }
+    struct Scanner {
+        const char *name;
+        TabScanner scan;
+    };
+    // the scanners this CPU can run, fastest first
+    static vector<Scanner> getSupportedScanners();
+
+  private:
+    static const TabScanner SCANNER;
+};
+
+} /* namespace sophia */
+
+#endif /* SAMTOKENIZER_H_ */
@@ -25,9 +25,12 @@
 #ifndef SUPPALIGNMENT_H_
 #define SUPPALIGNMENT_H_
 #include "CigarChunk.h"
+#include "ReadParameters.h"
+#include "SaTag.h"
 #include <algorithm>
 #include <array>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -37,19 +40,20 @@ using namespace std;
 
 class SuppAlignment {
   public:
-    SuppAlignment(string::const_iterator saCbegin,
-                  string::const_iterator saCend, bool primaryIn,
-                  bool lowMapqSourceIn, bool nullMapqSourceIn,
-                  bool alignmentOnForwardStrand, bool bpEncounteredM,
-                  int originIndexIn, int bpChrIndex, int bpPos);
+    SuppAlignment(const SaEntry &saEntry, bool primaryIn, bool lowMapqSourceIn,
+                  bool nullMapqSourceIn, bool alignmentOnForwardStrand,
+                  bool bpEncounteredM, int originIndexIn, int bpChrIndex,
+                  int bpPos, const ReadParameters &readParameters);
     SuppAlignment(int chrIndexIn, int posIn, int mateSupportIn,
                   int expectedDiscordantsIn, bool encounteredMIn,
                   bool invertedIn, int extendedPosIn, bool primaryIn,
                   bool lowMapqSourceIn, bool nullMapqSourceIn,
-                  int originIndexIn);
+                  int originIndexIn, const ReadParameters &readParameters);
+    // parsed from the breakpoint files, with DEFAULTREADLENGTH
     SuppAlignment(const string &saIn);
     ~SuppAlignment() = default;
-    static double ISIZEMAX;
+    // the read length of the breakpoint files sophiaAnnotate and sophiaMref
+    // parse
     static int DEFAULTREADLENGTH;
     string print() const;
     void extendSuppAlignment(int minPos, int maxPos) {
@@ -194,6 +198,7 @@ class SuppAlignment {
     }
 
   private:
+    int defaultReadLength;
     int matchFuzziness;
     int chrIndex;
     int pos;
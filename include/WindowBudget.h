@@ -0,0 +1,71 @@
+/*
+ * WindowBudget.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#ifndef WINDOWBUDGET_H_
+#define WINDOWBUDGET_H_
+#include <ostream>
+
+namespace sophia {
+
+using namespace std;
+
+// Memory budget of the open breakpoints and discordant mate pools of a
+// SamSegmentMapper. Over the budget the evidence is sampled, at a level
+// raised by one step at every update while the window stays over the budget,
+// and lowered again once it has been below half of it for a while. The
+// counters of the coverage window are never sampled. The regions mapped with
+// sampling go to the log, if there is one, with the peak estimated memory of
+// the window. The input blocks of a SamLineReader that retained alignments
+// pin are left out, sampling could not shrink them.
+class WindowBudget {
+  public:
+    // the estimates of the memory held by a clipped read and by a mate
+    static const long ALIGNMENTBYTES = 1024;
+    static const long MATEBYTES = 64;
+    WindowBudget(long budgetBytesIn, ostream *logIn);
+    ~WindowBudget() { endRegion(); }
+    int getSamplingLevel() const { return samplingLevel; }
+    // the window at pos holds retainedAlignments clipped reads and
+    // retainedMates mates
+    void update(int chrIndex, int pos, long retainedAlignments,
+                long retainedMates);
+    // the window was emptied at the end of a chromosome
+    void endRegion();
+
+  private:
+    static const int MAXSAMPLINGLEVEL = 10;
+    // positions from the last change of the level before it is lowered,
+    // about the length of the window of 150 bp reads, so that the change
+    // shows before
+    static const int LEVELDISTANCE = 1024;
+    const long BUDGETBYTES;
+    ostream *log;
+    int samplingLevel;
+    int levelChangedAt;
+    int regionChrIndex, regionStart, regionEnd;
+    int regionLevel;
+    long regionPeakBytes;
+};
+
+} /* namespace sophia */
+
+#endif /* WINDOWBUDGET_H_ */
@@ -6,18 +6,39 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <algorithm>
+#include <memory>
 #include <vector>
 #include <map>
 #include <set>
 #include "Alignment.h"
+#include "BamReader.h"
+#include "Checkpoint.h"
+#include "CramReader.h"
+#include "IndexedBamMapper.h"
+#include "MergedRecordReader.h"
+#include "PairedSampleMapper.h"
+#include "ReadCalibrator.h"
+#include "ReadFilter.h"
+#include "ReadParameters.h"
+#include "ReplayRecordReader.h"
+#include "SamLineReader.h"
 #include "SuppAlignment.h"
 #include "Breakpoint.h"
 #include "SamSegmentMapper.h"
 #include "ChrConverter.h"
+#include "DepthTrack.h"
+#include "WindowBudget.h"
 #include "HelperFunctions.h"
 
 std::pair<double, double> getIsizeParameters(const std::string &ISIZEFILE);
+bool applyCalibration(const sophia::ReadCalibrator &calibrator, int isizeSigmaLevel, int &defaultReadLength, double &isizeMax);
+bool openLog(const boost::program_options::variables_map &inputVariables, const std::string &option, std::ofstream &log);
+bool truncateOutput(off_t length);
+std::unique_ptr<sophia::RecordReader> openRecordReader(const std::vector<std::string> &bamFiles, const std::vector<std::string> &cramFiles, const std::string &referenceFile, int threads);
 int main(int argc, char** argv) {
 	std::ios_base::sync_with_stdio(false);
 	std::cin.tie(nullptr);
@@ -34,7 +55,34 @@ int main(int argc, char** argv) {
 	("lowqualclipsize", boost::program_options::value<int>(), "Maximum length of a low qality split read overhang for discarding. (5)") //
 	("isizesigma", boost::program_options::value<int>(), "The number of sds a s's mate has to be away to be called as discordant. (5)") //
 	("bpsupport", boost::program_options::value<int>(), "Minimum number of reads supporting a discordant contig. (5)") //
-	("properpairpercentage", boost::program_options::value<double>(), "Proper pair ratio as a percentage (100.0)");
+	("properpairpercentage", boost::program_options::value<double>(), "Proper pair ratio as a percentage (100.0)") //
+	("bam", boost::program_options::value<std::vector<std::string>>(), "Read alignments directly from this BAM file instead of SAM lines on stdin. Applies the default -F 0x600 -f 0x001 filter itself, see --requireflags and --excludeflags. Given several times, the coordinate sorted --bam and --cram inputs are merged like samtools merge would, each read on its own thread.") //
+	("cram", boost::program_options::value<std::vector<std::string>>(), "Read alignments directly from this CRAM 3.0 file instead of SAM lines on stdin. Applies the default -F 0x600 -f 0x001 filter itself, see --requireflags and --excludeflags. Can be given several times, like --bam.") //
+	("reference", boost::program_options::value<std::string>(), "Reference FASTA the --cram input was compressed against (with or without a .fai index).") //
+	("controlbam", boost::program_options::value<std::vector<std::string>>(), "Map this BAM file of the control sample in the same run, in lockstep with the tumour input. Can be given several times, like --bam. The control sample is mapped with the same parameters as the tumour, except for those given by the options below.") //
+	("controlcram", boost::program_options::value<std::vector<std::string>>(), "Map this CRAM file of the control sample in the same run, like --controlbam.") //
+	("controloutput", boost::program_options::value<std::string>(), "File the breakpoints of the --controlbam or --controlcram input are written to.") //
+	("controldefaultreadlength", boost::program_options::value<int>(), "Default read length of the --controlbam or --controlcram input. (that of the tumour input)") //
+	("controlmedianisize", boost::program_options::value<double>(), "Median insert size of the --controlbam or --controlcram input, given together with --controlstdisizepercentage. (that of the tumour input)") //
+	("controlstdisizepercentage", boost::program_options::value<double>(), "Percentage standard deviation of the insert size of the --controlbam or --controlcram input.") //
+	("threads", boost::program_options::value<int>(), "Number of threads classifying the reads, and decompressing --bam and --cram input, split between the inputs if there are several. (1)") //
+	("parallelchromosomes", "Map the chromosomes of a coordinate sorted and indexed --bam input in parallel, on --threads threads. Contigs and regions dropped by the filters below are skipped without decompressing them.") //
+	("requireflags", boost::program_options::value<std::string>(), "Only map reads with all of these FLAG bits set, like samtools view -f. (0x001 for --bam and --cram input, 0 for SAM input)") //
+	("excludeflags", boost::program_options::value<std::string>(), "Only map reads with none of these FLAG bits set, like samtools view -F. (0x600 for --bam and --cram input, 0 for SAM input)") //
+	("excludecontigs", boost::program_options::value<std::string>(), "Comma separated reference names whose reads are not mapped.") //
+	("includebed", boost::program_options::value<std::string>(), "Only map reads starting in the regions of this BED file.") //
+	("excludebed", boost::program_options::value<std::string>(), "Do not map reads starting in the regions of this BED file.") //
+	("blacklistbed", boost::program_options::value<std::string>(), "Do not map reads starting in the regions of this BED file, and do not count reads whose mate is in them as discordant. Replaces the built in hg19 region chr2:33140000-33150000 for mates. The mate regions are rounded out to 10 kb.") //
+	("autocalibrate", "Estimate the read length and the insert size distribution, where they are not given, from the first properly paired reads of the input. These reads are mapped afterwards as usual, so this needs no separate pass over the input.") //
+	("calibrationpairs", boost::program_options::value<int>(), "Number of proper pairs --autocalibrate estimates the insert size from. It looks at no more than ten times as many reads. (10000)") //
+	("depthtrack", boost::program_options::value<std::string>(), "Also write the mean coverage, normal span and low quality span counts of fixed size bins to this file, as bgzipped bedGraph. It is filled while mapping, without a pass over the input of its own. Bins without reads are left out.") //
+	("controldepthtrack", boost::program_options::value<std::string>(), "Like --depthtrack, for the --controlbam or --controlcram input.") //
+	("depthbinsize", boost::program_options::value<int>(), "Bin size of --depthtrack and --controldepthtrack. (1000)") //
+	("windowbudget", boost::program_options::value<int>(), "Memory budget in MB for the clipped reads and discordant mates kept around the current position, for each sample. Over the budget they are sampled, so that pathological high depth regions do not exhaust the memory, while the coverage counts stay exact. Counts a clipped read as 1 kB and a mate as 64 bytes, the SAM input blocks that retained reads keep are not counted. (unlimited)") //
+	("windowlog", boost::program_options::value<std::string>(), "File the regions mapped with sampled evidence under --windowbudget are written to, as BED with the peak memory estimate and the sampling level. The header names the report columns that are estimates in these regions.") //
+	("controlwindowlog", boost::program_options::value<std::string>(), "Like --windowlog, for the --controlbam or --controlcram input.") //
+	("checkpoint", boost::program_options::value<std::string>(), "Save the state of the run to this file once the output header is written, and again at the start of every further chromosome, after the breakpoints of the chromosomes before are written out, so that an interrupted run can go on with --resume. Needs a single --bam input.") //
+	("resume", "Go on with the interrupted run of the --checkpoint file from the chromosome it was working on, appending to its output. The standard output has to be redirected to that output with >>, it is cut back to its length at the checkpoint first. The other options have to be those of the interrupted run, and the output is the same as that of an uninterrupted run.");
 	boost::program_options::variables_map inputVariables { };
 	boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), inputVariables);
 	boost::program_options::notify(inputVariables);
@@ -42,10 +90,11 @@ int main(int argc, char** argv) {
 		std::cout << desc << std::endl;
 		return 0;
 	}
+	auto autoCalibrate = inputVariables.count("autocalibrate") > 0;
 	int defaultReadLength { 0 };
 	if (inputVariables.count("defaultreadlength")) {
 		defaultReadLength = inputVariables["defaultreadlength"].as<int>();
-	} else {
+	} else if (!autoCalibrate) {
 		std::cerr << "Default read Length not given, exiting" << std::endl;
 		return 1;
 	}
@@ -79,39 +128,320 @@ int main(int argc, char** argv) {
 		}
 	}
 	std::string mergedIsizeFile;
+	auto isizeMax = 0.0;
 	if (inputVariables.count("mergedisizes")) {
 		mergedIsizeFile = inputVariables["mergedisizes"].as<std::string>();
 		auto isizeparams = getIsizeParameters(mergedIsizeFile);
-		sophia::Alignment::ISIZEMAX = std::min(4000.0, isizeparams.first + isizeSigmaLevel * isizeparams.second);
-		sophia::SuppAlignment::ISIZEMAX = sophia::Alignment::ISIZEMAX;
+		isizeMax = std::min(4000.0, isizeparams.first + isizeSigmaLevel * isizeparams.second);
 	} else {
 		if (inputVariables.count("medianisize") && inputVariables.count("stdisizepercentage")) {
 			auto medianIsize = inputVariables["medianisize"].as<double>();
 			auto isizeStdPercentage = inputVariables["stdisizepercentage"].as<double>();
-			sophia::Alignment::ISIZEMAX = std::min(4000.0, medianIsize + isizeSigmaLevel * medianIsize * isizeStdPercentage * 0.01);
-			sophia::SuppAlignment::ISIZEMAX = sophia::Alignment::ISIZEMAX;
-		} else {
-			sophia::Alignment::ISIZEMAX = 2000.0;
-			sophia::SuppAlignment::ISIZEMAX = 2000.0;
+			isizeMax = std::min(4000.0, medianIsize + isizeSigmaLevel * medianIsize * isizeStdPercentage * 0.01);
+		} else if (!autoCalibrate) {
+			isizeMax = 2000.0;
 			std::cerr << "No insert size distribution file given, using a dummy default value of 2000 as the min insert size of a distant event" << std::endl;
 		}
 	}
+	// what is still 0 is estimated from the first reads of the input
+	auto calibrate = defaultReadLength == 0 || isizeMax == 0.0;
+	auto calibrationPairs = 10000;
+	if (inputVariables.count("calibrationpairs")) {
+		calibrationPairs = inputVariables["calibrationpairs"].as<int>();
+	}
+	sophia::ReadCalibrator calibrator { calibrationPairs };
 	sophia::Alignment::CLIPPEDNUCLEOTIDECOUNTTHRESHOLD = clipSize;
 	sophia::Alignment::BASEQUALITYTHRESHOLD = baseQuality + 33;
 	sophia::Alignment::BASEQUALITYTHRESHOLDLOW = baseQualityLow + 33;
 	sophia::Alignment::LOWQUALCLIPTHRESHOLD = lowQualClipSize;
 	sophia::Breakpoint::BPSUPPORTTHRESHOLD = bpSupport;
-	sophia::Breakpoint::DEFAULTREADLENGTH = defaultReadLength;
-	sophia::Breakpoint::DISCORDANTLOWQUALLEFTRANGE = static_cast<int>(std::round(defaultReadLength * 1.11));
-	sophia::Breakpoint::DISCORDANTLOWQUALRIGHTRANGE = static_cast<int>(std::round(defaultReadLength * 0.51));
-
-	sophia::SuppAlignment::DEFAULTREADLENGTH = defaultReadLength;
 	sophia::ChosenBp::BPSUPPORTTHRESHOLD = bpSupport;
-	std::cout << sophia::Breakpoint::COLUMNSSTR;
-	sophia::SamSegmentMapper segmentRefMaster { defaultReadLength };
-	segmentRefMaster.parseSamStream();
+	if (inputVariables.count("controlmedianisize") != inputVariables.count("controlstdisizepercentage")) {
+		std::cerr << "--controlmedianisize and --controlstdisizepercentage have to be given together, exiting" << std::endl;
+		return 1;
+	}
+	if (inputVariables.count("windowbudget") && inputVariables["windowbudget"].as<int>() <= 0) {
+		std::cerr << "--windowbudget has to be a positive number of MB, exiting" << std::endl;
+		return 1;
+	}
+	auto resume = inputVariables.count("resume") > 0;
+	std::unique_ptr<sophia::Checkpoint> checkpoint;
+	if (inputVariables.count("checkpoint")) {
+		if (inputVariables.count("bam") != 1 || inputVariables["bam"].as<std::vector<std::string>>().size() != 1 || inputVariables.count("cram") || inputVariables.count("controlbam") || inputVariables.count("controlcram") || inputVariables.count("parallelchromosomes")) {
+			std::cerr << "--checkpoint needs a single --bam input, exiting" << std::endl;
+			return 1;
+		}
+		checkpoint = std::make_unique<sophia::Checkpoint>(inputVariables["checkpoint"].as<std::string>(), inputVariables["bam"].as<std::vector<std::string>>().front());
+	}
+	if (resume) {
+		if (!checkpoint) {
+			std::cerr << "--resume needs the --checkpoint file of the interrupted run, exiting" << std::endl;
+			return 1;
+		}
+		if (inputVariables.count("depthtrack") || inputVariables.count("windowlog")) {
+			std::cerr << "--depthtrack and --windowlog do not work with --resume, exiting" << std::endl;
+			return 1;
+		}
+		struct stat bamStat;
+		if (stat(inputVariables["bam"].as<std::vector<std::string>>().front().c_str(), &bamStat) != 0 || !S_ISREG(bamStat.st_mode)) {
+			std::cerr << "--resume needs a --bam file it can seek in, not a pipe, exiting" << std::endl;
+			return 1;
+		}
+		checkpoint->load();
+		if (checkpoint->isFinished()) {
+			std::cerr << "The run of " << inputVariables["checkpoint"].as<std::string>() << " is finished already" << std::endl;
+			return 0;
+		}
+		if (!truncateOutput(sophia::Breakpoint::COLUMNSSTR.size() + checkpoint->getOutputBytes())) {
+			return 1;
+		}
+		if (checkpoint->getLastChrIndex() == 0) {
+			std::cerr << "Resuming from the first chromosome" << std::endl;
+		} else {
+			std::cerr << "Resuming after chromosome " << sophia::ChrConverter::indexToChr[checkpoint->getLastChrIndex()] << std::endl;
+		}
+	} else {
+		std::cout << sophia::Breakpoint::COLUMNSSTR;
+	}
+	auto threads = 1;
+	if (inputVariables.count("threads")) {
+		threads = inputVariables["threads"].as<int>();
+	}
+	sophia::ReadFilter readFilter { };
+	auto binaryInput = inputVariables.count("bam") || inputVariables.count("cram");
+	auto requiredFlags = binaryInput ? 0x001 : 0, excludedFlags = binaryInput ? 0x600 : 0;
+	if (inputVariables.count("requireflags")) {
+		requiredFlags = std::stoi(inputVariables["requireflags"].as<std::string>(), nullptr, 0);
+	}
+	if (inputVariables.count("excludeflags")) {
+		excludedFlags = std::stoi(inputVariables["excludeflags"].as<std::string>(), nullptr, 0);
+	}
+	readFilter.setFlags(requiredFlags, excludedFlags);
+	if (inputVariables.count("excludecontigs")) {
+		readFilter.excludeContigs(inputVariables["excludecontigs"].as<std::string>());
+	}
+	if (inputVariables.count("includebed")) {
+		readFilter.addRegions(inputVariables["includebed"].as<std::string>(), true);
+	}
+	if (inputVariables.count("excludebed")) {
+		readFilter.addRegions(inputVariables["excludebed"].as<std::string>(), false);
+	}
+	if (inputVariables.count("blacklistbed")) {
+		auto blacklistFile = inputVariables["blacklistbed"].as<std::string>();
+		readFilter.addRegions(blacklistFile, false);
+		sophia::SamSegmentMapper::MATEBLACKLIST = sophia::RegionBitmap { };
+		sophia::SamSegmentMapper::MATEBLACKLIST.addBed(blacklistFile);
+	}
+	if (inputVariables.count("parallelchromosomes")) {
+		if (inputVariables.count("bam") != 1 || inputVariables["bam"].as<std::vector<std::string>>().size() != 1 || inputVariables.count("cram") || inputVariables.count("controlbam") || inputVariables.count("controlcram")) {
+			std::cerr << "--parallelchromosomes needs a single indexed --bam input, exiting" << std::endl;
+			return 1;
+		}
+		if (inputVariables.count("depthtrack") || inputVariables.count("windowbudget")) {
+			std::cerr << "--depthtrack and --windowbudget do not work with --parallelchromosomes, exiting" << std::endl;
+			return 1;
+		}
+		auto bamFile = inputVariables["bam"].as<std::vector<std::string>>().front();
+		if (calibrate) {
+			sophia::BamReader calibrationReader { bamFile, 1 };
+			sophia::ReplayRecordReader recordReader { calibrationReader };
+			calibrator.calibrate(recordReader);
+			if (!applyCalibration(calibrator, isizeSigmaLevel, defaultReadLength, isizeMax)) {
+				return 1;
+			}
+		}
+		sophia::IndexedBamMapper indexedBamMapper { bamFile, sophia::ReadParameters { defaultReadLength, isizeMax }, threads, readFilter };
+		indexedBamMapper.run();
+		return 0;
+	}
+	std::vector<std::string> bamFiles, cramFiles, controlBamFiles, controlCramFiles;
+	if (inputVariables.count("bam")) {
+		bamFiles = inputVariables["bam"].as<std::vector<std::string>>();
+	}
+	if (inputVariables.count("cram")) {
+		cramFiles = inputVariables["cram"].as<std::vector<std::string>>();
+	}
+	if (inputVariables.count("controlbam")) {
+		controlBamFiles = inputVariables["controlbam"].as<std::vector<std::string>>();
+	}
+	if (inputVariables.count("controlcram")) {
+		controlCramFiles = inputVariables["controlcram"].as<std::vector<std::string>>();
+	}
+	std::string referenceFile;
+	if (inputVariables.count("reference")) {
+		referenceFile = inputVariables["reference"].as<std::string>();
+	}
+	auto pairedSamples = !controlBamFiles.empty() || !controlCramFiles.empty();
+	if (pairedSamples && !inputVariables.count("controloutput")) {
+		std::cerr << "--controlbam and --controlcram need a --controloutput file, exiting" << std::endl;
+		return 1;
+	}
+	auto inputCount = std::max<size_t>(1, bamFiles.size() + cramFiles.size()) + controlBamFiles.size() + controlCramFiles.size();
+	auto inputThreads = std::max(1, threads / static_cast<int>(inputCount));
+	std::unique_ptr<sophia::RecordReader> binaryReader;
+	std::unique_ptr<sophia::ReplayRecordReader> recordReader;
+	std::unique_ptr<sophia::SamLineReader> lineReader;
+	sophia::ReadBatchPipeline::BatchFiller fillTumour;
+	if (binaryInput) {
+		if (resume) {
+			// the first reads are still calibrated from, they were already mapped
+			if (calibrate) {
+				sophia::BamReader calibrationReader { bamFiles.front(), 1 };
+				sophia::ReplayRecordReader calibrationRecords { calibrationReader };
+				calibrator.calibrate(calibrationRecords);
+			}
+			binaryReader = std::make_unique<sophia::BamReader>(bamFiles.front(), inputThreads, checkpoint->getInputOffset());
+		} else {
+			binaryReader = openRecordReader(bamFiles, cramFiles, referenceFile, inputThreads);
+			if (checkpoint) {
+				// a run killed in the first chromosome resumes from the first record
+				std::cout.flush();
+				checkpoint->save(0, binaryReader->tell(), 0, 0);
+			}
+		}
+		// the records read for the calibration are handed out once more
+		recordReader = std::make_unique<sophia::ReplayRecordReader>(*binaryReader);
+		if (calibrate && !resume) {
+			calibrator.calibrate(*recordReader);
+		}
+		fillTumour = [&recordReader, &readFilter](sophia::ReadBatch &batch) {
+			return batch.fill(*recordReader, readFilter);
+		};
+	} else {
+		lineReader = std::make_unique<sophia::SamLineReader>(stdin);
+		if (calibrate) {
+			calibrator.calibrate(*lineReader);
+		}
+		fillTumour = [&lineReader, &readFilter](sophia::ReadBatch &batch) {
+			return batch.fill(*lineReader, readFilter);
+		};
+	}
+	if (calibrate && !applyCalibration(calibrator, isizeSigmaLevel, defaultReadLength, isizeMax)) {
+		return 1;
+	}
+	const sophia::ReadParameters readParameters { defaultReadLength, isizeMax };
+	sophia::BreakpointOutput output { false, std::cout };
+	if (resume) {
+		output.restore(checkpoint->getIndexCount(), checkpoint->getOutputBytes());
+	}
+	auto depthBinSize = 1000;
+	if (inputVariables.count("depthbinsize")) {
+		depthBinSize = inputVariables["depthbinsize"].as<int>();
+	}
+	std::unique_ptr<sophia::DepthTrack> depthTrack, controlDepthTrack;
+	std::unique_ptr<sophia::WindowBudget> windowBudget, controlWindowBudget;
+	std::ofstream windowLog, controlWindowLog;
+	if (inputVariables.count("depthtrack")) {
+		depthTrack = std::make_unique<sophia::DepthTrack>(inputVariables["depthtrack"].as<std::string>(), depthBinSize);
+	}
+	if (pairedSamples && inputVariables.count("controldepthtrack")) {
+		controlDepthTrack = std::make_unique<sophia::DepthTrack>(inputVariables["controldepthtrack"].as<std::string>(), depthBinSize);
+	}
+	if (inputVariables.count("windowbudget")) {
+		auto budgetBytes = inputVariables["windowbudget"].as<int>() * 1048576L;
+		if (!openLog(inputVariables, "windowlog", windowLog) || !openLog(inputVariables, "controlwindowlog", controlWindowLog)) {
+			return 1;
+		}
+		windowBudget = std::make_unique<sophia::WindowBudget>(budgetBytes, windowLog.is_open() ? &windowLog : nullptr);
+		if (pairedSamples) {
+			controlWindowBudget = std::make_unique<sophia::WindowBudget>(budgetBytes, controlWindowLog.is_open() ? &controlWindowLog : nullptr);
+		}
+	}
+	if (pairedSamples) {
+		auto controlReader = openRecordReader(controlBamFiles, controlCramFiles, referenceFile, inputThreads);
+		// the control input is binary, so it gets the default flags of binary input
+		auto controlFilter = readFilter;
+		controlFilter.setFlags(inputVariables.count("requireflags") ? requiredFlags : 0x001, inputVariables.count("excludeflags") ? excludedFlags : 0x600);
+		std::ofstream controlStream { inputVariables["controloutput"].as<std::string>() };
+		if (!controlStream) {
+			std::cerr << "Error opening " << inputVariables["controloutput"].as<std::string>() << ", exiting" << std::endl;
+			return 1;
+		}
+		controlStream << sophia::Breakpoint::COLUMNSSTR;
+		sophia::BreakpointOutput controlOutput { false, controlStream };
+		// the control is mapped with the parameters of the tumour unless it has its own
+		auto controlDefaultReadLength = defaultReadLength;
+		if (inputVariables.count("controldefaultreadlength")) {
+			controlDefaultReadLength = inputVariables["controldefaultreadlength"].as<int>();
+		}
+		auto controlIsizeMax = isizeMax;
+		if (inputVariables.count("controlmedianisize")) {
+			auto medianIsize = inputVariables["controlmedianisize"].as<double>();
+			auto isizeStdPercentage = inputVariables["controlstdisizepercentage"].as<double>();
+			controlIsizeMax = std::min(4000.0, medianIsize + isizeSigmaLevel * medianIsize * isizeStdPercentage * 0.01);
+		}
+		const sophia::ReadParameters controlReadParameters { controlDefaultReadLength, controlIsizeMax };
+		sophia::PairedSampleMapper pairedMapper { readParameters, controlReadParameters, threads, output, controlOutput, depthTrack.get(), controlDepthTrack.get(), windowBudget.get(), controlWindowBudget.get() };
+		pairedMapper.run(fillTumour, [&controlReader, &controlFilter](sophia::ReadBatch &batch) {
+			return batch.fill(*controlReader, controlFilter);
+		});
+	} else {
+		sophia::SamSegmentMapper segmentRefMaster { readParameters, threads, output, depthTrack.get(), windowBudget.get(), checkpoint.get() };
+		segmentRefMaster.parseBatches(fillTumour);
+	}
 	return 0;
 }
+bool applyCalibration(const sophia::ReadCalibrator &calibrator, int isizeSigmaLevel, int &defaultReadLength, double &isizeMax) {
+	if (defaultReadLength == 0) {
+		defaultReadLength = calibrator.getReadLength();
+		if (defaultReadLength == 0) {
+			std::cerr << "No reads to estimate the default read length from, exiting" << std::endl;
+			return false;
+		}
+		std::cerr << "Estimated default read length: " << defaultReadLength << std::endl;
+	}
+	if (isizeMax == 0.0) {
+		if (calibrator.hasIsizes()) {
+			isizeMax = std::min(4000.0, calibrator.getMedianIsize() + isizeSigmaLevel * calibrator.getIsizeStd());
+			std::cerr << "Estimated insert size median: " << calibrator.getMedianIsize() << ", standard deviation: " << calibrator.getIsizeStd() << std::endl;
+		} else {
+			isizeMax = 2000.0;
+			std::cerr << "Too few proper pairs to estimate the insert size from, using a dummy default value of 2000 as the min insert size of a distant event" << std::endl;
+		}
+	}
+	return true;
+}
+bool openLog(const boost::program_options::variables_map &inputVariables, const std::string &option, std::ofstream &log) {
+	if (inputVariables.count(option)) {
+		log.open(inputVariables[option].as<std::string>());
+		if (!log) {
+			std::cerr << "Error opening " << inputVariables[option].as<std::string>() << ", exiting" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+bool truncateOutput(off_t length) {
+	// appended to, the output goes on right after the cut
+	struct stat outputStat;
+	auto flags = fcntl(STDOUT_FILENO, F_GETFL);
+	if (fstat(STDOUT_FILENO, &outputStat) != 0 || !S_ISREG(outputStat.st_mode) || flags == -1 || (flags & O_APPEND) == 0) {
+		std::cerr << "--resume appends to the output of the interrupted run, redirect the standard output to it with >>, exiting" << std::endl;
+		return false;
+	}
+	if (outputStat.st_size < length) {
+		std::cerr << "The output is shorter than at the checkpoint, exiting" << std::endl;
+		return false;
+	}
+	if (ftruncate(STDOUT_FILENO, length) != 0) {
+		perror("Error cutting back the output");
+		return false;
+	}
+	return true;
+}
+std::unique_ptr<sophia::RecordReader> openRecordReader(const std::vector<std::string> &bamFiles, const std::vector<std::string> &cramFiles, const std::string &referenceFile, int threads) {
+	std::vector<std::unique_ptr<sophia::RecordReader>> readers;
+	for (const auto &bamFile : bamFiles) {
+		readers.push_back(std::make_unique<sophia::BamReader>(bamFile, threads));
+	}
+	for (const auto &cramFile : cramFiles) {
+		readers.push_back(std::make_unique<sophia::CramReader>(cramFile, referenceFile, threads));
+	}
+	if (readers.size() == 1) {
+		return std::move(readers.front());
+	}
+	return std::make_unique<sophia::MergedRecordReader>(std::move(readers));
+}
 std::pair<double, double> getIsizeParameters(const std::string &ISIZEFILE) {
 	std::pair<double, double> isizeMedianStd { };
 	std::ifstream infile { ISIZEFILE };
@@ -6,66 +6,141 @@
 CPP_SRCS += \
 ../src/Alignment.cpp \
 ../src/AnnotationProcessor.cpp \
+../src/BamReader.cpp \
+../src/BedReader.cpp \
+../src/BgzfReader.cpp \
+../src/BgzfWriter.cpp \
 ../src/Breakpoint.cpp \
+../src/BreakpointFinalizer.cpp \
+../src/BreakpointOutput.cpp \
 ../src/BreakpointReduced.cpp \
+../src/BreakpointWindow.cpp \
+../src/Checkpoint.cpp \
 ../src/ChosenBp.cpp \
 ../src/ChrConverter.cpp \
+../src/CompactAlignment.cpp \
+../src/CoverageWindow.cpp \
+../src/CramCodecs.cpp \
+../src/CramReader.cpp \
+../src/DepthTrack.cpp \
 ../src/DeFuzzier.cpp \
 ../src/GermlineMatch.cpp \
 ../src/MasterRefProcessor.cpp \
 ../src/MrefEntry.cpp \
 ../src/MrefEntryAnno.cpp \
 ../src/MrefMatch.cpp \
+../src/PackedOverhang.cpp \
+../src/QualityHistogram.cpp \
+../src/ReadBatch.cpp \
+../src/ReadBatchPipeline.cpp \
+../src/ReadFilter.cpp \
+../src/RecordReader.cpp \
+../src/ReferenceFasta.cpp \
+../src/RegionBitmap.cpp \
+../src/SaTag.cpp \
+../src/SamLineReader.cpp \
 ../src/SamSegmentMapper.cpp \
+../src/SamTokenizer.cpp \
 ../src/Sdust.cpp \
 ../src/SuppAlignment.cpp \
 ../src/SuppAlignmentAnno.cpp \
-../src/SvEvent.cpp 
+../src/SvEvent.cpp \
+../src/WindowBudget.cpp 
 
 OBJS += \
 ./src/Alignment.o \
 ./src/AnnotationProcessor.o \
+./src/BamReader.o \
+./src/BedReader.o \
+./src/BgzfReader.o \
+./src/BgzfWriter.o \
 ./src/Breakpoint.o \
+./src/BreakpointFinalizer.o \
+./src/BreakpointOutput.o \
 ./src/BreakpointReduced.o \
+./src/BreakpointWindow.o \
+./src/Checkpoint.o \
 ./src/ChosenBp.o \
 ./src/ChrConverter.o \
+./src/CompactAlignment.o \
+./src/CoverageWindow.o \
+./src/CramCodecs.o \
+./src/CramReader.o \
+./src/DepthTrack.o \
 ./src/DeFuzzier.o \
 ./src/GermlineMatch.o \
 ./src/MasterRefProcessor.o \
 ./src/MrefEntry.o \
 ./src/MrefEntryAnno.o \
 ./src/MrefMatch.o \
+./src/PackedOverhang.o \
+./src/QualityHistogram.o \
+./src/ReadBatch.o \
+./src/ReadBatchPipeline.o \
+./src/ReadFilter.o \
+./src/RecordReader.o \
+./src/ReferenceFasta.o \
+./src/RegionBitmap.o \
+./src/SaTag.o \
+./src/SamLineReader.o \
 ./src/SamSegmentMapper.o \
+./src/SamTokenizer.o \
 ./src/Sdust.o \
 ./src/SuppAlignment.o \
 ./src/SuppAlignmentAnno.o \
-./src/SvEvent.o 
+./src/SvEvent.o \
+./src/WindowBudget.o 
 
 CPP_DEPS += \
 ./src/Alignment.d \
 ./src/AnnotationProcessor.d \
+./src/BamReader.d \
+./src/BedReader.d \
+./src/BgzfReader.d \
+./src/BgzfWriter.d \
 ./src/Breakpoint.d \
+./src/BreakpointFinalizer.d \
+./src/BreakpointOutput.d \
 ./src/BreakpointReduced.d \
+./src/BreakpointWindow.d \
+./src/Checkpoint.d \
 ./src/ChosenBp.d \
 ./src/ChrConverter.d \
+./src/CompactAlignment.d \
+./src/CoverageWindow.d \
+./src/CramCodecs.d \
+./src/CramReader.d \
+./src/DepthTrack.d \
 ./src/DeFuzzier.d \
 ./src/GermlineMatch.d \
 ./src/MasterRefProcessor.d \
 ./src/MrefEntry.d \
 ./src/MrefEntryAnno.d \
 ./src/MrefMatch.d \
+./src/PackedOverhang.d \
+./src/QualityHistogram.d \
+./src/ReadBatch.d \
+./src/ReadBatchPipeline.d \
+./src/ReadFilter.d \
+./src/RecordReader.d \
+./src/ReferenceFasta.d \
+./src/RegionBitmap.d \
+./src/SaTag.d \
+./src/SamLineReader.d \
 ./src/SamSegmentMapper.d \
+./src/SamTokenizer.d \
 ./src/Sdust.d \
 ./src/SuppAlignment.d \
 ./src/SuppAlignmentAnno.d \
-./src/SvEvent.d 
+./src/SvEvent.d \
+./src/WindowBudget.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 src/%.o: ../src/%.cpp
 	@echo 'Building file: $<'
 	@echo 'Invoking: GCC C++ Compiler'
-	g++ -std=c++1y -I"/home/umuttoprak/cppProjectsCevelop/sophia/include" -O3 -Wall -c -fmessage-length=0 -static -flto -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -o "$@" "$<"
+	g++ -std=c++1z -I"/home/umuttoprak/cppProjectsCevelop/sophia/include" -O3 -Wall -c -fmessage-length=0 -static -flto -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -23,13 +23,15 @@
  */
 
 #include "Alignment.h"
-#include "ChrConverter.h"
 #include "HelperFunctions.h"
 #include "MateInfo.h"
+#include "QualityHistogram.h"
+#include "SamTokenizer.h"
 #include "Sdust.h"
 #include "strtk.hpp"
-#include <bitset>
+#include <cstring>
 #include <iostream>
+#include <limits>
 
 namespace sophia {
 
@@ -40,62 +42,100 @@ int Alignment::LOWQUALCLIPTHRESHOLD{}, Alignment::BASEQUALITYTHRESHOLD{},
     Alignment::CLIPPEDNUCLEOTIDECOUNTTHRESHOLD{},
     Alignment::INDELNUCLEOTIDECOUNTTHRESHOLD{};
 
-double Alignment::ISIZEMAX{};
 Alignment::Alignment()
-    : lowMapq{false}, nullMapq{true}, distantMate{0}, chosenBp{nullptr},
-      chrIndex{0}, readType{0}, startPos{0}, endPos{0}, mateChrIndex{0},
-      matePos{0}, samLine{}, validLine{error_terminating_getline(cin, samLine)},
-      samChunkPositions{}, saCbegin{}, saCend{}, hasSa{false},
-      supplementary{false}, fwdStrand{true}, invertedMate{false}, qualChecked{
-                                                                      false} {
-    if (validLine) {
-        auto index = 0;
-        for (auto it = samLine.cbegin(); it != samLine.cend(); ++it) {
-            if (*it == '\t') {
-                samChunkPositions.push_back(index);
-            }
-            ++index;
-        }
-        chrIndex = ChrConverter::readChromosomeIndex(
-            next(samLine.cbegin(), samChunkPositions[1] + 1), '\t');
+    : CompactAlignment{}, chosenBp{}, samLine{}, lineBlock{},
+      samChunkPositions{}, saEntries{}, hasSa{false},
+      qualChecked{false}, cigarChunks{}, readBreakpoints{},
+      readBreakpointTypes{}, readBreakpointSizes{},
+      readBreakpointComplexityMaskRatios{}, readBreakpointsEncounteredM{},
+      readOverhangCoords{}, fromBamRecord{false}, decodedFields{},
+      sequenceStart{0}, qualityStart{0}, qualityEnd{0}, saTagStart{-1},
+      saTagEnd{-1} {}
+
+void
+Alignment::assign(const CompactAlignment &read, string_view samLineIn,
+                  shared_ptr<const vector<char>> lineBlockIn,
+                  const vector<int> &fieldTabs) {
+    clearRead(read);
+    fromBamRecord = false;
+    samLine = samLineIn;
+    lineBlock = move(lineBlockIn);
+    samChunkPositions.assign(fieldTabs.begin(), fieldTabs.end());
+    sequenceStart = 1 + samChunkPositions[8];
+    qualityStart = 1 + samChunkPositions[9];
+    qualityEnd = samChunkPositions.size() > 10
+                     ? samChunkPositions[10]
+                     : static_cast<int>(samLine.size());
+    if (eventCandidate) {
+        createCigarChunks();
     }
 }
 
 void
-Alignment::continueConstruction() {
-    mappingQualityCheck();
-    for (auto startPos_cit = samLine.cbegin() + 1 + samChunkPositions[2];
-         startPos_cit != samLine.cbegin() + samChunkPositions[3];
-         ++startPos_cit) {
-        startPos = startPos * 10 + (*startPos_cit - '0');
+Alignment::assign(const CompactAlignment &read, const BamRecord &record) {
+    clearRead(read);
+    fromBamRecord = true;
+    samLine = string_view{};
+    lineBlock.reset();
+    samChunkPositions.clear();
+    if (eventCandidate) {
+        createCigarChunks(record);
+        // only clipped and indel reads ever look at bases, qualities and
+        // supplementary alignments, so only they get them decoded
+        auto sequenceLength = record.getSequenceLength();
+        auto saTag = record.findStringTag('S', 'A');
+        auto saLength = saTag == nullptr ? 0 : strlen(saTag);
+        decodedFields.reserve(2 * sequenceLength + saLength);
+        for (auto i = 0; i < sequenceLength; ++i) {
+            decodedFields.push_back(record.getBase(i));
+        }
+        qualityStart = sequenceLength;
+        for (auto i = 0; i < sequenceLength; ++i) {
+            auto quality = record.getQuality(i);
+            decodedFields.push_back(
+                static_cast<char>((quality == 0xff ? 0 : quality) + 33));
+        }
+        qualityEnd = static_cast<int>(decodedFields.size());
+        if (saLength > 0 && saTag[saLength - 1] == ';') {
+            saTagStart = static_cast<int>(decodedFields.size());
+            decodedFields.append(saTag, saLength - 1);
+            saTagEnd = static_cast<int>(decodedFields.size());
+        }
+        samLine = decodedFields;
     }
-    auto readLength = (samChunkPositions[9] - samChunkPositions[8] - 1);
-    endPos = startPos + readLength;
+}
 
-    auto flag = 0;
-    for (auto flag_cit = samLine.cbegin() + 1 + samChunkPositions[0];
-         flag_cit != samLine.cbegin() + samChunkPositions[1]; ++flag_cit) {
-        flag = flag * 10 + (*flag_cit - '0');
-    }
-    auto flags = bitset<12>(flag);
-    supplementary = (flags[11] == true);
-    fwdStrand = (flags[4] == false);
-    auto mateFwdStrand = (flags[5] == false);
-    invertedMate = (fwdStrand == mateFwdStrand);
+void
+Alignment::clearRead(const CompactAlignment &read) {
+    CompactAlignment::operator=(read);
+    saEntries.clear();
+    hasSa = false;
+    qualChecked = false;
+    cigarChunks.clear();
+    readBreakpoints.clear();
+    readBreakpointTypes.clear();
+    readBreakpointSizes.clear();
+    readBreakpointComplexityMaskRatios.clear();
+    readBreakpointsEncounteredM.clear();
+    readOverhangCoords.clear();
+    decodedFields.clear();
+    sequenceStart = 0;
+    qualityStart = 0;
+    qualityEnd = 0;
+    saTagStart = -1;
+    saTagEnd = -1;
+}
 
-    bool eventCandidate = isEventCandidate();
+void
+Alignment::continueConstruction(double isizeMax) {
+    beyondIsizeMax = insertSize > isizeMax;
     if (eventCandidate) {
-        createCigarChunks();
         assignBreakpointsAndOverhangs();
         if (supplementary) {
-            auto startCit = next(samLine.cbegin(), 1 + samChunkPositions[9]);
-            auto endCit = next(samLine.cbegin(), samChunkPositions[10]);
-            vector<int> overhangPerBaseQuality{};
-            fullMedianQuality(startCit, endCit, overhangPerBaseQuality);
-            if (overhangPerBaseQuality.empty() ||
-                getMedian(overhangPerBaseQuality.begin(),
-                          overhangPerBaseQuality.end()) <
-                    BASEQUALITYTHRESHOLD) {
+            if (QualityHistogram::median(samLine.data() + qualityStart,
+                                         samLine.data() + qualityEnd,
+                                         BASEQUALITYTHRESHOLDLOW) <
+                BASEQUALITYTHRESHOLD) {
                 readType = 5;
             } else {
                 readType = 2;
@@ -135,86 +175,16 @@ Alignment::continueConstruction() {
         if (readType < 5) {
             qualityCheckCascade();
         }
-    } else if (readType == 7) {
-        readType = 5;
-    }
-    switch (readType) {
-    case 0:
-    case 3:
-    case 5:
-        assessOutlierMateDistance();
-        if (distantMate == 1 && readType != 5) {
-            readType = 4;
-        }
-        break;
-    default:
-        break;
-    }
-    for (auto mpos_cit = samLine.cbegin() + 1 + samChunkPositions[6];
-         mpos_cit != samLine.cbegin() + samChunkPositions[7]; ++mpos_cit) {
-        matePos = matePos * 10 + (*mpos_cit - '0');
-    }
-    if (samLine[1 + samChunkPositions[5]] == '=') {
-        mateChrIndex = chrIndex;
-    } else {
-        mateChrIndex = ChrConverter::readChromosomeIndex(
-            next(samLine.cbegin(), 1 + samChunkPositions[5]), '\t');
-    }
-}
-
-void
-Alignment::mappingQualityCheck() {
-    if (samLine[1 + samChunkPositions[3]] !=
-        '0') {   // mapq 0 is treated as a special case, where number of SAs and
-                 // base qualities will be the sole determinants of read quality
-        nullMapq = false;
-        switch (samChunkPositions[4] - samChunkPositions[3]) {
-        case 2:   // this checks if the mapq is a single-digit number
-            readType = 7;
-            lowMapq = true;
-            break;
-        case 3:
-            if (samLine[1 + samChunkPositions[3]] == '1' &&
-                ((samLine[2 + samChunkPositions[3]] - '0') < 3)) {
-                // this checks if the mapq is a two-digit number, and if the
-                // first digit is a "1", that the second digit is less than 3
-                readType = 7;
-                lowMapq = true;
-            }
-            break;
-        default:
-            break;
-        }
-    }
-}
-
-bool
-Alignment::isEventCandidate() const {
-    if (samLine[samChunkPositions[5] - 1] != 'M') {
-        return true;
+        markDistantMate();
     } else {
-        for (auto cigarString_cit = samLine.cbegin() + 1 + samChunkPositions[4];
-             cigarString_cit != samLine.cbegin() + samChunkPositions[5] - 1;
-             ++cigarString_cit) {
-            switch (*cigarString_cit) {
-            case 'S':
-            case 'H':
-            case 'I':
-            case 'D':
-                return true;
-            default:
-                break;
-            }
-        }
-        return false;
+        classifyPlainRead(isizeMax);
     }
 }
 
 void
 Alignment::createCigarChunks() {
-    auto encounteredM = false;
-    auto cumulativeNucleotideCount = 0, currentNucleotideCount = 0,
-         indelAdjustment = 0, leftClipAdjustment = 0, rightClipAdjustment = 0;
+    CigarScan scan{};
+    auto currentNucleotideCount = 0;
     for (auto cigarString_cit = samLine.cbegin() + 1 + samChunkPositions[4];
          cigarString_cit != samLine.cbegin() + samChunkPositions[5];
          ++cigarString_cit) {
@@ -222,56 +192,74 @@ Alignment::createCigarChunks() {
             currentNucleotideCount =
                 currentNucleotideCount * 10 + (*cigarString_cit - '0');
         } else {
-            switch (*cigarString_cit) {
-            case 'M':
-                encounteredM = true;
-                cumulativeNucleotideCount += currentNucleotideCount;
-                break;
-            case 'S':
-                cigarChunks.emplace_back(*cigarString_cit, encounteredM,
-                                         cumulativeNucleotideCount +
-                                             indelAdjustment -
-                                             leftClipAdjustment,
-                                         currentNucleotideCount,
-                                         indelAdjustment - leftClipAdjustment);
-                cumulativeNucleotideCount += currentNucleotideCount;
-                if (!encounteredM) {
-                    leftClipAdjustment = currentNucleotideCount;
-                } else {
-                    rightClipAdjustment = currentNucleotideCount;
-                }
-                break;
-            case 'H':
-                cigarChunks.emplace_back(*cigarString_cit, encounteredM,
-                                         cumulativeNucleotideCount +
-                                             indelAdjustment -
-                                             leftClipAdjustment,
-                                         currentNucleotideCount);
-                break;
-            case 'I':
-                cigarChunks.emplace_back(*cigarString_cit, encounteredM,
-                                         cumulativeNucleotideCount +
-                                             indelAdjustment -
-                                             leftClipAdjustment,
-                                         currentNucleotideCount);
-                cumulativeNucleotideCount += currentNucleotideCount;
-                indelAdjustment -= currentNucleotideCount;
-                break;
-            case 'D':
-                cigarChunks.emplace_back(*cigarString_cit, encounteredM,
-                                         cumulativeNucleotideCount +
-                                             indelAdjustment -
-                                             leftClipAdjustment,
-                                         currentNucleotideCount);
-                indelAdjustment += currentNucleotideCount;
-                break;
-            default:
-                break;
-            }
+            addCigarChunk(*cigarString_cit, currentNucleotideCount, scan);
             currentNucleotideCount = 0;
         }
     }
-    endPos += indelAdjustment - leftClipAdjustment - rightClipAdjustment;
+    endPos += scan.indelAdjustment - scan.leftClipAdjustment -
+              scan.rightClipAdjustment;
+}
+
+void
+Alignment::createCigarChunks(const BamRecord &record) {
+    CigarScan scan{};
+    for (auto i = 0; i < record.getCigarOperationCount(); ++i) {
+        addCigarChunk(record.getCigarOperationType(i),
+                      record.getCigarOperationLength(i), scan);
+    }
+    endPos += scan.indelAdjustment - scan.leftClipAdjustment -
+              scan.rightClipAdjustment;
+}
+
+void
+Alignment::addCigarChunk(char chunkType, int length, CigarScan &scan) {
+    switch (chunkType) {
+    case 'M':
+        scan.encounteredM = true;
+        scan.cumulativeNucleotideCount += length;
+        break;
+    case 'S':
+        cigarChunks.emplace_back(chunkType, scan.encounteredM,
+                                 scan.cumulativeNucleotideCount +
+                                     scan.indelAdjustment -
+                                     scan.leftClipAdjustment,
+                                 length,
+                                 scan.indelAdjustment -
+                                     scan.leftClipAdjustment);
+        scan.cumulativeNucleotideCount += length;
+        if (!scan.encounteredM) {
+            scan.leftClipAdjustment = length;
+        } else {
+            scan.rightClipAdjustment = length;
+        }
+        break;
+    case 'H':
+        cigarChunks.emplace_back(chunkType, scan.encounteredM,
+                                 scan.cumulativeNucleotideCount +
+                                     scan.indelAdjustment -
+                                     scan.leftClipAdjustment,
+                                 length);
+        break;
+    case 'I':
+        cigarChunks.emplace_back(chunkType, scan.encounteredM,
+                                 scan.cumulativeNucleotideCount +
+                                     scan.indelAdjustment -
+                                     scan.leftClipAdjustment,
+                                 length);
+        scan.cumulativeNucleotideCount += length;
+        scan.indelAdjustment -= length;
+        break;
+    case 'D':
+        cigarChunks.emplace_back(chunkType, scan.encounteredM,
+                                 scan.cumulativeNucleotideCount +
+                                     scan.indelAdjustment -
+                                     scan.leftClipAdjustment,
+                                 length);
+        scan.indelAdjustment += length;
+        break;
+    default:
+        break;
+    }
 }
 
 void
@@ -378,6 +366,44 @@ Alignment::clipCountCheck() {
     return (hCounts < 2 && !(hCounts > 0 && sCounts > 0));
 }
 
+void
+Alignment::decodeSaTag() {
+    string_view saValue{};
+    if (!fromBamRecord &&
+        static_cast<int>(samChunkPositions.size()) == FIELDTABS) {
+        SamTokenizer::findTabs(samLine.data(), samChunkPositions.back() + 1,
+                               static_cast<int>(samLine.size()),
+                               numeric_limits<int>::max(), samChunkPositions);
+    }
+    if (fromBamRecord) {
+        if (saTagStart != -1) {
+            saValue = samLine.substr(saTagStart, saTagEnd - saTagStart);
+            hasSa = true;
+        }
+    } else if (samLine.back() == ';' &&
+               samLine[samChunkPositions.back() + 1] == 'S' &&
+               samLine[samChunkPositions.back() + 2] == 'A') {
+        saValue = samLine.substr(samChunkPositions.back() + 6);
+        saValue.remove_suffix(1);
+        hasSa = true;
+    } else {
+        for (auto i = 10u; i < samChunkPositions.size() - 1; ++i) {
+            if (samLine[samChunkPositions[i + 1] - 1] == ';' &&
+                samLine[samChunkPositions[i] + 1] == 'S' &&
+                samLine[samChunkPositions[i] + 2] == 'A') {
+                saValue = samLine.substr(samChunkPositions[i] + 6,
+                                         samChunkPositions[i + 1] -
+                                             samChunkPositions[i] - 7);
+                hasSa = true;
+                break;
+            }
+        }
+    }
+    if (hasSa) {
+        SaTag::decode(saValue, saEntries);
+    }
+}
+
 bool
 Alignment::uniqueSuppCheck() {
     auto hCounts = 0, sCounts = 0;
@@ -393,61 +419,22 @@ Alignment::uniqueSuppCheck() {
             break;
         }
     }
-    saCbegin = samLine.cend();
-    saCend = samLine.cend();
-    if (samLine.back() == ';' && samLine[samChunkPositions.back() + 1] == 'S' &&
-        samLine[samChunkPositions.back() + 2] == 'A') {
-        saCbegin = samLine.cbegin() + samChunkPositions.back() + 6;
-        saCend = samLine.cend() - 1;
-        hasSa = true;
-    } else {
-        for (auto i = 10u; i < samChunkPositions.size() - 1; ++i) {
-            if (samLine[samChunkPositions[i + 1] - 1] == ';' &&
-                samLine[samChunkPositions[i] + 1] == 'S' &&
-                samLine[samChunkPositions[i] + 2] == 'A') {
-                saCbegin = samLine.cbegin() + samChunkPositions[i] + 6;
-                saCend = samLine.cbegin() + samChunkPositions[i + 1] - 1;
-                hasSa = true;
-                break;
-            }
-        }
+    if (!hasSa) {
+        decodeSaTag();
     }
-    if (hasSa) {
-        auto lowQualSacounts = 0;
-        auto block = 0;
-        auto mapq = 0;
-        auto highQualSa = false;
-        for (auto saCit = saCbegin; saCit != saCend; ++saCit) {
-            //"SA:Z:10,24753146,+,68S33M,48,1;X,135742083,-,47S22M32S,0,0;8,72637925,-,29S19M53S,0,0;"
-            // 0-chr,1-pos,2-orientation,3-cigar,4-mapq,5-whatever
-            switch (*saCit) {
-            case ',':
-                ++block;
-                if (block == 4) {
-                    ++saCit;
-                    while (*saCit != ',') {
-                        mapq = mapq * 10 + (*saCit - '0');
-                        ++saCit;
-                    }
-                }
-                break;
-            case ';':
-                if (mapq < 13) {
-                    ++lowQualSacounts;
-                } else if (mapq > 20) {
-                    highQualSa = true;
-                }
-                if (!highQualSa && ((sCounts == 1 && lowQualSacounts == 2) ||
-                                    (hCounts == 1 && lowQualSacounts == 2) ||
-                                    (sCounts == 2 && lowQualSacounts == 4))) {
-                    return false;
-                }
-                block = 0;
-                mapq = 0;
-                break;
-            default:
-                break;
-            }
+    // the mapq of the last SA entry has never been evaluated
+    auto lowQualSacounts = 0;
+    auto highQualSa = false;
+    for (auto i = 0u; i + 1 < saEntries.size(); ++i) {
+        if (saEntries[i].mapq < 13) {
+            ++lowQualSacounts;
+        } else if (saEntries[i].mapq > 20) {
+            highQualSa = true;
+        }
+        if (!highQualSa && ((sCounts == 1 && lowQualSacounts == 2) ||
+                            (hCounts == 1 && lowQualSacounts == 2) ||
+                            (sCounts == 2 && lowQualSacounts == 4))) {
+            return false;
         }
     }
     return true;
@@ -455,33 +442,13 @@ Alignment::uniqueSuppCheck() {
 
 double
 Alignment::overhangMedianQuality(const CigarChunk &cigarChunk) const {
-    vector<int> overhangPerBaseQuality{};
-    if (!cigarChunk.encounteredM) {
-        auto startCit = next(samLine.cbegin(), 1 + samChunkPositions[9] +
-                                                   cigarChunk.startPosOnRead -
-                                                   cigarChunk.indelAdjustment);
-        auto endCit =
-            next(samLine.cbegin(),
-                 1 + samChunkPositions[9] + cigarChunk.startPosOnRead -
-                     cigarChunk.indelAdjustment + cigarChunk.length);
-        fullMedianQuality(startCit, endCit, overhangPerBaseQuality);
-    } else {
-        string::const_reverse_iterator startCrit{
-            next(samLine.cbegin(),
-                 1 + samChunkPositions[9] + cigarChunk.startPosOnRead -
-                     cigarChunk.indelAdjustment + cigarChunk.length)};
-        string::const_reverse_iterator endCrit{
-            next(samLine.cbegin(), 1 + samChunkPositions[9] +
-                                       cigarChunk.startPosOnRead -
-                                       cigarChunk.indelAdjustment)};
-        fullMedianQuality(startCrit, endCrit, overhangPerBaseQuality);
-    }
-    if (overhangPerBaseQuality.empty()) {
-        return -1.0;
-    } else {
-        return getMedian(overhangPerBaseQuality.begin(),
-                         overhangPerBaseQuality.end());
-    }
+    // the order of the qualities only matters for where a low quality run is
+    // found, so reverse overhangs are read front to back as well
+    auto overhangStart = samLine.data() + qualityStart +
+                         cigarChunk.startPosOnRead - cigarChunk.indelAdjustment;
+    return QualityHistogram::median(overhangStart,
+                                    overhangStart + cigarChunk.length,
+                                    BASEQUALITYTHRESHOLDLOW);
 }
 
 void
@@ -531,37 +498,6 @@ Alignment::assessReadType() {
     }
 }
 
-bool
-Alignment::assessOutlierMateDistance() {
-    switch (distantMate) {
-    case -1:
-        return false;
-    case 1:
-        return true;
-    default:
-        if (*(samLine.cbegin() + 1 + samChunkPositions[5]) != '=') {
-            distantMate = 1;
-            return true;
-        } else {
-            auto isize_cit = samLine.cbegin() + 1 + samChunkPositions[7];
-            if (*isize_cit == '-') {
-                ++isize_cit;
-            }
-            auto isize = 0;
-            for (; isize_cit != samLine.cbegin() + samChunkPositions[8];
-                 ++isize_cit) {
-                isize = isize * 10 + (*isize_cit - '0');
-            }
-            if (isize > ISIZEMAX) {
-                distantMate = 1;
-                return true;
-            }
-        }
-        distantMate = -1;
-        return false;
-    }
-}
-
 void
 Alignment::setChosenBp(int chosenBpLoc, int alignmentIndex) {
     auto overhangStartIndex = 0;
@@ -577,7 +513,7 @@ Alignment::setChosenBp(int chosenBpLoc, int alignmentIndex) {
                 for (const auto &overhang : readOverhangCoords) {
                     if (overhang.bpPos == chosenBpLoc) {
                         overhangStartIndex =
-                            1 + samChunkPositions[8] + overhang.startPosOnRead;
+                            sequenceStart + overhang.startPosOnRead;
                         overhangLength = overhang.length;
                         break;
                     }
@@ -587,38 +523,19 @@ Alignment::setChosenBp(int chosenBpLoc, int alignmentIndex) {
             break;
         }
     }
-    chosenBp.reset();
-    chosenBp = make_unique<ChosenBp>(bpType, bpSize, bpEncounteredM,
-                                     overhangStartIndex, overhangLength,
-                                     alignmentIndex);
+    chosenBp.assign(bpType, bpSize, bpEncounteredM, overhangStartIndex,
+                    overhangLength, alignmentIndex);
 }
 vector<SuppAlignment>
-Alignment::generateSuppAlignments(int bpChrIndex, int bpPos) {
+Alignment::generateSuppAlignments(int bpChrIndex, int bpPos,
+                                  const ReadParameters &readParameters) {
     vector<SuppAlignment> suppAlignmentsTmp;
-    if (hasSa) {
-        vector<string::const_iterator> saBegins = {saCbegin};
-        vector<string::const_iterator> saEnds;
-        for (auto it = saCbegin; it != saCend; ++it) {
-            if (*it == ';') {
-                saEnds.push_back(it);
-                saBegins.push_back(it + 1);
-            }
-        }
-        saEnds.push_back(saCend);
-        for (auto i = 0u; i < saBegins.size(); ++i) {
-            SuppAlignment saTmp{saBegins[i],
-                                saEnds[i],
-                                !supplementary,
-                                lowMapq,
-                                nullMapq,
-                                fwdStrand,
-                                chosenBp->bpEncounteredM,
-                                chosenBp->selfNodeIndex,
-                                bpChrIndex,
-                                bpPos};
-            if (saTmp.getChrIndex() < 1002) {
-                suppAlignmentsTmp.push_back(saTmp);
-            }
+    for (const auto &saEntry : saEntries) {
+        if (saEntry.chrIndex < 1002) {
+            suppAlignmentsTmp.emplace_back(
+                saEntry, !supplementary, lowMapq, nullMapq, fwdStrand,
+                chosenBp.bpEncounteredM, chosenBp.selfNodeIndex, bpChrIndex,
+                bpPos, readParameters);
         }
     }
     if (assessOutlierMateDistance()) {
@@ -635,27 +552,38 @@ Alignment::generateSuppAlignments(int bpChrIndex, int bpPos) {
             if (!foundMatch) {
                 suppAlignmentsTmp.emplace_back(
                     getMateChrIndex(), getMatePos(), 0, 0,
-                    chosenBp->bpEncounteredM, invertedMate, getMatePos() + 1,
-                    !supplementary, lowMapq, nullMapq, chosenBp->selfNodeIndex);
+                    chosenBp.bpEncounteredM, invertedMate, getMatePos() + 1,
+                    !supplementary, lowMapq, nullMapq, chosenBp.selfNodeIndex,
+                    readParameters);
             }
         }
     }
     return suppAlignmentsTmp;
 }
+
+shared_ptr<Alignment>
+Alignment::clone() const {
+    auto copy = make_shared<Alignment>(*this);
+    if (samLine.data() == decodedFields.data()) {
+        copy->samLine = copy->decodedFields;
+    }
+    return copy;
+}
+
 string
 Alignment::printOverhang() const {
     string res{};
-    res.reserve(chosenBp->overhangLength + 9);
-    if (chosenBp->bpEncounteredM) {
-        res.append("|").append(samLine.substr(chosenBp->overhangStartIndex,
-                                              chosenBp->overhangLength));
+    res.reserve(chosenBp.overhangLength + 9);
+    if (chosenBp.bpEncounteredM) {
+        res.append("|").append(samLine.substr(chosenBp.overhangStartIndex,
+                                              chosenBp.overhangLength));
     } else {
-        res.append(samLine.substr(chosenBp->overhangStartIndex,
-                                  chosenBp->overhangLength))
+        res.append(samLine.substr(chosenBp.overhangStartIndex,
+                                  chosenBp.overhangLength))
             .append("|");
     }
     res.append("(")
-        .append(strtk::type_to_string<int>(chosenBp->childrenNodes.size()))
+        .append(strtk::type_to_string<int>(chosenBp.childrenNodes.size()))
         .append(")");
     return res;
 }
@@ -665,8 +593,8 @@ Alignment::overhangComplexityMaskRatio() const {
     auto fullSizesTotal = 0.0;
     auto maskedIntervalsTotal = 0.0;
     vector<int> overhang;
-    for (auto i = 0; i < chosenBp->overhangLength; ++i) {
-        switch (samLine[chosenBp->overhangStartIndex + i]) {
+    for (auto i = 0; i < chosenBp.overhangLength; ++i) {
+        switch (samLine[chosenBp.overhangStartIndex + i]) {
         case 'A':
             overhang.push_back(0);
             break;
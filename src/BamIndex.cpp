@@ -0,0 +1,107 @@
+/*
+ * BamIndex.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "BamIndex.h"
+#include "HelperFunctions.h"
+#include <algorithm>
+#include <iostream>
+
+namespace sophia {
+
+using namespace std;
+
+BamIndex::BamIndex(const string &bamFileName)
+    : fileName{bamFileName + ".bai"}, fileHandle{fopen(fileName.c_str(), "rb")},
+      firstOffsets{}, linearOffsets{} {
+    if (fileHandle == nullptr && bamFileName.size() > 4 &&
+        bamFileName.compare(bamFileName.size() - 4, 4, ".bam") == 0) {
+        fileName = bamFileName.substr(0, bamFileName.size() - 4) + ".bai";
+        fileHandle = fopen(fileName.c_str(), "rb");
+    }
+    if (fileHandle == nullptr) {
+        cerr << "No BAI index found for " << bamFileName << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    char magic[4];
+    if (fread(magic, 1, 4, fileHandle) != 4 || magic[0] != 'B' ||
+        magic[1] != 'A' || magic[2] != 'I' || magic[3] != 1) {
+        cerr << fileName << " is not a BAI index" << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    auto referenceCount = readValue<int32_t>();
+    for (auto i = 0; i < referenceCount; ++i) {
+        // the smallest chunk start of the real bins, the pseudo-bin only
+        // carries statistics
+        auto firstOffset = UINT64_MAX;
+        auto binCount = readValue<int32_t>();
+        for (auto j = 0; j < binCount; ++j) {
+            auto bin = readValue<uint32_t>();
+            auto chunkCount = readValue<int32_t>();
+            for (auto k = 0; k < chunkCount; ++k) {
+                auto chunkStart = readValue<uint64_t>();
+                readValue<uint64_t>();
+                if (bin != PSEUDOBIN) {
+                    firstOffset = min(firstOffset, chunkStart);
+                }
+            }
+        }
+        auto intervalCount = readValue<int32_t>();
+        linearOffsets.emplace_back();
+        for (auto j = 0; j < intervalCount; ++j) {
+            linearOffsets.back().push_back(readValue<uint64_t>());
+        }
+        firstOffsets.push_back(firstOffset == UINT64_MAX ? 0 : firstOffset);
+    }
+    fclose(fileHandle);
+}
+
+template <typename T>
+T
+BamIndex::readValue() {
+    T value{0};
+    if (fread(&value, sizeof(value), 1, fileHandle) != 1) {
+        cerr << "Truncated BAI index " << fileName << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    return value;
+}
+
+uint64_t
+BamIndex::getFirstOffset(int refId) const {
+    if (refId < 0 || refId >= static_cast<int>(firstOffsets.size())) {
+        return 0;
+    }
+    return firstOffsets[refId];
+}
+
+uint64_t
+BamIndex::getOffset(int refId, int pos) const {
+    if (refId < 0 || refId >= static_cast<int>(linearOffsets.size())) {
+        return 0;
+    }
+    auto window = static_cast<size_t>(pos >> WINDOWSHIFT);
+    if (window >= linearOffsets[refId].size()) {
+        return 0;
+    }
+    return linearOffsets[refId][window];
+}
+
+} /* namespace sophia */
@@ -0,0 +1,103 @@
+/*
+ * BamReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "BamReader.h"
+#include "HelperFunctions.h"
+#include <iostream>
+
+namespace sophia {
+
+using namespace std;
+
+BamReader::BamReader(const string &fileNameIn, int threadsIn)
+    : fileName{fileNameIn}, bgzfReader{fileNameIn, threadsIn}, recordBuffer{} {
+    readHeader(bgzfReader);
+}
+
+BamReader::BamReader(const string &fileNameIn, int threadsIn,
+                     uint64_t startOffset)
+    : fileName{fileNameIn}, bgzfReader{fileNameIn, threadsIn, startOffset},
+      recordBuffer{} {
+    BgzfReader headerReader{fileNameIn, 1};
+    readHeader(headerReader);
+}
+
+void
+BamReader::readHeader(BgzfReader &headerReader) {
+    char magic[4];
+    if (!headerReader.read(magic, 4) || magic[0] != 'B' || magic[1] != 'A' ||
+        magic[2] != 'M' || magic[3] != 1) {
+        cerr << fileName << " is not a BAM file" << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    auto textLength = readInt32(headerReader);
+    vector<char> text(textLength);
+    headerReader.read(text.data(), textLength);
+    auto referenceCount = readInt32(headerReader);
+    for (auto i = 0; i < referenceCount; ++i) {
+        auto nameLength = readInt32(headerReader);
+        string name(nameLength, '\0');
+        headerReader.read(&name[0], nameLength);
+        name.pop_back();
+        readInt32(headerReader);
+        addReference(name);
+    }
+}
+
+int32_t
+BamReader::readInt32(BgzfReader &headerReader) {
+    int32_t value{0};
+    if (!headerReader.read(reinterpret_cast<char *>(&value), sizeof(value))) {
+        cerr << "Unexpected end of BAM file " << fileName << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    return value;
+}
+
+bool
+BamReader::nextRecord(BamRecord &record) {
+    int32_t blockSize{0};
+    if (!bgzfReader.read(reinterpret_cast<char *>(&blockSize),
+                         sizeof(blockSize))) {
+        return false;
+    }
+    if (blockSize < 32) {
+        cerr << "Corrupt BAM record in " << fileName << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    if (recordBuffer.size() < static_cast<size_t>(blockSize)) {
+        recordBuffer.resize(blockSize);
+    }
+    if (!bgzfReader.read(recordBuffer.data(), blockSize)) {
+        cerr << "Unexpected end of BAM file " << fileName << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    record.assign(recordBuffer.data(), blockSize);
+    if (!record.isWellFormed()) {
+        cerr << "Corrupt BAM record in " << fileName << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    record.setChrIndices(toChrIndex(record.getRefId()),
+                         toChrIndex(record.getMateRefId()));
+    return true;
+}
+
+} /* namespace sophia */
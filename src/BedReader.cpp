@@ -0,0 +1,61 @@
+/*
+ * BedReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+
+#include "BedReader.h"
+#include "HelperFunctions.h"
+#include <iostream>
+#include <sstream>
+
+namespace sophia {
+
+using namespace std;
+
+BedReader::BedReader(const string &fileNameIn)
+    : fileName{fileNameIn}, bedFile{fileNameIn} {
+    if (!bedFile) {
+        cerr << "Error opening BED file " << fileName << endl;
+        exit(EXITCODE_IOERROR);
+    }
+}
+
+bool
+BedReader::nextInterval(string &contig, int &start, int &end) {
+    string line;
+    while (getline(bedFile, line)) {
+        if (line.empty() || line[0] == '#' ||
+            line.compare(0, 5, "track") == 0 ||
+            line.compare(0, 7, "browser") == 0) {
+            continue;
+        }
+        istringstream fields{line};
+        if (!(fields >> contig >> start >> end) || start < 0 || end < start) {
+            cerr << "Malformed line in BED file " << fileName << ": " << line
+                 << endl;
+            exit(EXITCODE_IOERROR);
+        }
+        return true;
+    }
+    return false;
+}
+
+} /* namespace sophia */
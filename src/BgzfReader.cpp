@@ -0,0 +1,305 @@
+/*
+ * BgzfReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "BgzfReader.h"
+#include "HelperFunctions.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <zlib.h>
+
+namespace sophia {
+
+using namespace std;
+
+BgzfReader::BgzfReader(const string &fileNameIn, int threadsIn)
+    : BgzfReader{fileNameIn, threadsIn, 0} {}
+
+BgzfReader::BgzfReader(const string &fileNameIn, int threadsIn,
+                       uint64_t startOffset)
+    : fileName{fileNameIn}, THREADS{max(1, threadsIn)},
+      fileHandle{fopen(fileNameIn.c_str(), "rb")}, nextFileOffset{0},
+      blockPool{}, currentBlock{nullptr}, currentIndex{0}, freeBlocks{},
+      pendingBlocks{}, inflateQueue{}, endOfFile{false}, shuttingDown{false},
+      threadPool{} {
+    if (fileHandle == nullptr) {
+        perror(("Error opening " + fileName).c_str());
+        exit(EXITCODE_IOERROR);
+    }
+    // only a resumed run seeks, streamed input from a pipe or /dev/stdin
+    // cannot
+    nextFileOffset = startOffset >> 16;
+    if (nextFileOffset != 0 &&
+        fseeko(fileHandle, static_cast<off_t>(nextFileOffset), SEEK_SET) !=
+            0) {
+        formatError(errno == ESPIPE
+                        ? "cannot resume on input that is not seekable"
+                        : "virtual offset beyond the end of the file");
+    }
+    // one block is held by the consumer, the rest may be queued or inflating
+    auto poolSize = THREADS > 1 ? 4 * THREADS + 1 : 1;
+    for (auto i = 0; i < poolSize; ++i) {
+        blockPool.push_back(make_unique<Block>());
+        freeBlocks.push_back(blockPool.back().get());
+    }
+    if (THREADS > 1) {
+        threadPool.emplace_back(&BgzfReader::ioLoop, this);
+        for (auto i = 0; i < THREADS; ++i) {
+            threadPool.emplace_back(&BgzfReader::workerLoop, this);
+        }
+    }
+    vector<char> skipped(startOffset & 0xffff);
+    if (!skipped.empty() && !read(skipped.data(), skipped.size())) {
+        formatError("virtual offset beyond the end of the file");
+    }
+}
+
+BgzfReader::~BgzfReader() {
+    {
+        lock_guard<mutex> lock{queueMutex};
+        shuttingDown = true;
+    }
+    slotAvailable.notify_all();
+    workAvailable.notify_all();
+    blockReady.notify_all();
+    for (auto &worker : threadPool) {
+        worker.join();
+    }
+    fclose(fileHandle);
+}
+
+bool
+BgzfReader::read(char *dest, size_t length) {
+    auto copied = size_t{0};
+    while (copied < length) {
+        if (currentBlock == nullptr ||
+            currentIndex == currentBlock->inflated.size()) {
+            if (!nextBlock()) {
+                if (copied > 0) {
+                    formatError("unexpected end of file");
+                }
+                return false;
+            }
+            continue;
+        }
+        auto chunk =
+            min(length - copied, currentBlock->inflated.size() - currentIndex);
+        memcpy(dest + copied, currentBlock->inflated.data() + currentIndex,
+               chunk);
+        currentIndex += chunk;
+        copied += chunk;
+    }
+    return true;
+}
+
+void
+BgzfReader::seek(uint64_t virtualOffset) {
+    if (THREADS > 1) {
+        formatError("seeking needs a single-threaded reader");
+    }
+    if (fseeko(fileHandle, static_cast<off_t>(virtualOffset >> 16),
+               SEEK_SET) != 0) {
+        formatError("virtual offset beyond the end of the file");
+    }
+    nextFileOffset = virtualOffset >> 16;
+    if (!nextBlock()) {
+        formatError("virtual offset beyond the end of the file");
+    }
+    currentIndex = virtualOffset & 0xffff;
+    if (currentIndex > currentBlock->inflated.size()) {
+        formatError("virtual offset beyond the end of its block");
+    }
+}
+
+uint64_t
+BgzfReader::tell() const {
+    if (currentBlock == nullptr) {
+        return 0;
+    }
+    return currentBlock->fileOffset << 16 | currentIndex;
+}
+
+bool
+BgzfReader::nextBlock() {
+    if (THREADS == 1) {
+        currentBlock = blockPool.front().get();
+        currentIndex = 0;
+        if (!readCompressedBlock(*currentBlock)) {
+            currentBlock = nullptr;
+            return false;
+        }
+        inflateBlock(*currentBlock);
+        return true;
+    }
+    unique_lock<mutex> lock{queueMutex};
+    if (currentBlock != nullptr) {
+        freeBlocks.push_back(currentBlock);
+        currentBlock = nullptr;
+        slotAvailable.notify_one();
+    }
+    blockReady.wait(lock, [this] {
+        return (!pendingBlocks.empty() && pendingBlocks.front()->ready) ||
+               (pendingBlocks.empty() && endOfFile);
+    });
+    if (pendingBlocks.empty()) {
+        return false;
+    }
+    currentBlock = pendingBlocks.front();
+    pendingBlocks.pop_front();
+    currentIndex = 0;
+    return true;
+}
+
+void
+BgzfReader::ioLoop() {
+    while (true) {
+        Block *block{nullptr};
+        {
+            unique_lock<mutex> lock{queueMutex};
+            slotAvailable.wait(
+                lock, [this] { return !freeBlocks.empty() || shuttingDown; });
+            if (shuttingDown) {
+                return;
+            }
+            block = freeBlocks.back();
+            freeBlocks.pop_back();
+        }
+        block->ready = false;
+        auto blockRead = readCompressedBlock(*block);
+        {
+            lock_guard<mutex> lock{queueMutex};
+            if (!blockRead) {
+                freeBlocks.push_back(block);
+                endOfFile = true;
+            } else {
+                pendingBlocks.push_back(block);
+                inflateQueue.push_back(block);
+            }
+        }
+        if (!blockRead) {
+            blockReady.notify_all();
+            return;
+        }
+        workAvailable.notify_one();
+    }
+}
+
+void
+BgzfReader::workerLoop() {
+    while (true) {
+        Block *block{nullptr};
+        {
+            unique_lock<mutex> lock{queueMutex};
+            workAvailable.wait(lock, [this] {
+                return !inflateQueue.empty() || shuttingDown;
+            });
+            if (shuttingDown) {
+                return;
+            }
+            block = inflateQueue.front();
+            inflateQueue.pop_front();
+        }
+        inflateBlock(*block);
+        {
+            lock_guard<mutex> lock{queueMutex};
+            block->ready = true;
+        }
+        blockReady.notify_all();
+    }
+}
+
+bool
+BgzfReader::readCompressedBlock(Block &block) {
+    // gzip member header: ID1 ID2 CM FLG MTIME(4) XFL OS XLEN(2), then the
+    // extra subfields, one of which is BC carrying the total block size - 1
+    unsigned char header[12];
+    auto headerBytes = fread(header, 1, sizeof(header), fileHandle);
+    if (headerBytes == 0 && feof(fileHandle)) {
+        return false;
+    }
+    if (headerBytes != sizeof(header) || header[0] != 31 || header[1] != 139 ||
+        header[2] != 8 || (header[3] & 4) == 0) {
+        formatError("not a BGZF block header");
+    }
+    auto extraLength = header[10] | (header[11] << 8);
+    unsigned char extra[65536];
+    if (fread(extra, 1, extraLength, fileHandle) !=
+        static_cast<size_t>(extraLength)) {
+        formatError("truncated block header");
+    }
+    auto blockSize = -1;
+    for (auto i = 0; i + 4 <= extraLength;) {
+        auto subfieldLength = extra[i + 2] | (extra[i + 3] << 8);
+        if (extra[i] == 'B' && extra[i + 1] == 'C' && subfieldLength == 2 &&
+            i + 6 <= extraLength) {
+            blockSize = (extra[i + 4] | (extra[i + 5] << 8)) + 1;
+        }
+        i += 4 + subfieldLength;
+    }
+    auto remaining = blockSize - 12 - extraLength;
+    if (blockSize < 0 || remaining < 8) {
+        formatError("missing BGZF block size");
+    }
+    block.compressed.resize(remaining);
+    if (fread(block.compressed.data(), 1, remaining, fileHandle) !=
+        static_cast<size_t>(remaining)) {
+        formatError("truncated block");
+    }
+    block.fileOffset = nextFileOffset;
+    nextFileOffset += blockSize;
+    return true;
+}
+
+void
+BgzfReader::inflateBlock(Block &block) const {
+    // the block ends with CRC32 and ISIZE of the inflated data
+    const auto *trailer = block.compressed.data() + block.compressed.size() - 4;
+    auto inflatedSize = static_cast<uint32_t>(trailer[0]) |
+                        static_cast<uint32_t>(trailer[1]) << 8 |
+                        static_cast<uint32_t>(trailer[2]) << 16 |
+                        static_cast<uint32_t>(trailer[3]) << 24;
+    block.inflated.resize(inflatedSize);
+    if (inflatedSize == 0) {
+        return;
+    }
+    z_stream stream{};
+    if (inflateInit2(&stream, -15) != Z_OK) {
+        formatError("zlib initialization failed");
+    }
+    stream.next_in = const_cast<unsigned char *>(block.compressed.data());
+    stream.avail_in = static_cast<uInt>(block.compressed.size() - 8);
+    stream.next_out = reinterpret_cast<unsigned char *>(block.inflated.data());
+    stream.avail_out = inflatedSize;
+    auto status = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    if (status != Z_STREAM_END || stream.avail_out != 0) {
+        formatError("corrupt deflate stream");
+    }
+}
+
+void
+BgzfReader::formatError(const string &reason) const {
+    cerr << "Error reading BGZF file " << fileName << ": " << reason << endl;
+    exit(EXITCODE_IOERROR);
+}
+
+} /* namespace sophia */
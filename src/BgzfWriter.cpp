@@ -0,0 +1,113 @@
+/*
+ * BgzfWriter.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "BgzfWriter.h"
+#include "HelperFunctions.h"
+#include <algorithm>
+#include <iostream>
+#include <zlib.h>
+
+namespace sophia {
+
+using namespace std;
+
+BgzfWriter::BgzfWriter(const string &fileNameIn)
+    : fileName{fileNameIn}, fileHandle{fopen(fileNameIn.c_str(), "wb")},
+      pending{}, compressed(65536) {
+    if (fileHandle == nullptr) {
+        perror(("Error opening " + fileName).c_str());
+        exit(EXITCODE_IOERROR);
+    }
+    pending.reserve(BLOCKINPUT);
+}
+
+BgzfWriter::~BgzfWriter() {
+    if (!pending.empty()) {
+        writeBlock();
+    }
+    // the end of file marker is a block compressing nothing
+    writeBlock();
+    if (fclose(fileHandle) != 0) {
+        writeError();
+    }
+}
+
+void
+BgzfWriter::write(const char *data, size_t length) {
+    while (length > 0) {
+        auto chunk = min(length, BLOCKINPUT - pending.size());
+        pending.insert(pending.end(), data, data + chunk);
+        data += chunk;
+        length -= chunk;
+        if (pending.size() == BLOCKINPUT) {
+            writeBlock();
+        }
+    }
+}
+
+void
+BgzfWriter::writeBlock() {
+    // gzip member header with the BC subfield, see BgzfReader, followed by
+    // the raw deflate stream, CRC32 and ISIZE
+    const size_t headerLength = 18;
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        writeError();
+    }
+    stream.next_in = reinterpret_cast<unsigned char *>(pending.data());
+    stream.avail_in = static_cast<uInt>(pending.size());
+    stream.next_out = compressed.data() + headerLength;
+    stream.avail_out =
+        static_cast<uInt>(compressed.size() - headerLength - 8);
+    auto status = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END) {
+        writeError();
+    }
+    auto blockSize = headerLength + stream.total_out + 8;
+    const unsigned char header[headerLength]{
+        31, 139, 8, 4, 0, 0, 0, 0, 0, 255, 6, 0, 'B', 'C', 2, 0,
+        static_cast<unsigned char>((blockSize - 1) & 0xff),
+        static_cast<unsigned char>((blockSize - 1) >> 8)};
+    copy(header, header + headerLength, compressed.begin());
+    auto crc = crc32(0L, reinterpret_cast<unsigned char *>(pending.data()),
+                     static_cast<uInt>(pending.size()));
+    auto *trailer = compressed.data() + headerLength + stream.total_out;
+    for (auto i = 0; i < 4; ++i) {
+        trailer[i] = static_cast<unsigned char>(crc >> (8 * i));
+        trailer[4 + i] =
+            static_cast<unsigned char>(pending.size() >> (8 * i));
+    }
+    if (fwrite(compressed.data(), 1, blockSize, fileHandle) != blockSize) {
+        writeError();
+    }
+    pending.clear();
+}
+
+void
+BgzfWriter::writeError() const {
+    cerr << "Error writing BGZF file " << fileName << endl;
+    exit(EXITCODE_IOERROR);
+}
+
+} /* namespace sophia */
@@ -24,6 +24,7 @@
 
 #include "Breakpoint.h"
 #include "ChrConverter.h"
+#include "HelperFunctions.h"
 #include "strtk.hpp"
 #include <algorithm>
 #include <boost/algorithm/string/join.hpp>
@@ -49,38 +50,103 @@ const string Breakpoint::COLUMNSSTR = boost::join(
     "\t");
 int Breakpoint::BPSUPPORTTHRESHOLD{};
 int Breakpoint::DEFAULTREADLENGTH{};
-int Breakpoint::DISCORDANTLOWQUALLEFTRANGE{};
-int Breakpoint::DISCORDANTLOWQUALRIGHTRANGE{};
 double Breakpoint::IMPROPERPAIRRATIO{0.0};
 bool Breakpoint::PROPERPAIRCOMPENSATIONMODE{false};
-int Breakpoint::bpindex{0};
 
-Breakpoint::Breakpoint(int chrIndexIn, int posIn)
-    : covFinalized{false}, missingInfoBp{false}, chrIndex{chrIndexIn},
-      pos{posIn}, normalSpans{0}, lowQualSpansSoft{0}, lowQualSpansHard{0},
-      unpairedBreaksSoft{0}, unpairedBreaksHard{0}, breaksShortIndel{0},
-      lowQualBreaksSoft{0}, lowQualBreaksHard{0}, repetitiveOverhangBreaks{0},
-      pairedBreaksSoft{0}, pairedBreaksHard{0}, leftSideDiscordantCandidates{0},
+Breakpoint::Breakpoint(int chrIndexIn, int posIn,
+                       const ReadParameters &readParametersIn)
+    : readParameters{&readParametersIn}, covFinalized{false},
+      missingInfoBp{false}, chrIndex{chrIndexIn}, pos{posIn}, normalSpans{0},
+      lowQualSpansSoft{0}, lowQualSpansHard{0}, unpairedBreaksSoft{0},
+      unpairedBreaksHard{0}, breaksShortIndel{0}, lowQualBreaksSoft{0},
+      lowQualBreaksHard{0}, repetitiveOverhangBreaks{0}, pairedBreaksSoft{0},
+      pairedBreaksHard{0}, leftSideDiscordantCandidates{0},
       rightSideDiscordantCandidates{0}, mateSupport{0}, leftCoverage{0},
-      rightCoverage{0}, totalLowMapqHardClips{0},
-      hitsInMref{-1}, germline{false}, poolLeft{}, poolRight{},
-      poolLowQualLeft{}, poolLowQualRight{} {}
+      rightCoverage{0}, totalLowMapqHardClips{0}, softAlignmentCount{0},
+      hardAlignmentCount{0}, softSampled{false}, hardSampled{false},
+      softSampleScale{1.0}, hardSampleScale{1.0}, hitsInMref{-1},
+      germline{false}, eventTotal{0}, artifactTotal{0}, overhangIndex{0},
+      poolLeft{}, poolRight{}, poolLowQualLeft{}, poolLowQualRight{},
+      ownMates{} {}
 
+namespace {
+
+// algorithm R: the nth read replaces a random one of the reservoir with the
+// probability size / n
 void
-Breakpoint::addSoftAlignment(shared_ptr<Alignment> alignmentIn) {
+sampleIntoReservoir(vector<shared_ptr<Alignment>> &reservoir,
+                    shared_ptr<Alignment> alignment, int pos, int count) {
+    auto slot = mixBits(static_cast<uint64_t>(pos) << 32 | count) % count;
+    if (slot < reservoir.size()) {
+        reservoir[slot] = move(alignment);
+    }
+}
+
+// the mates offered to the pools that the records of a side stand for
+int
+offeredMates(const vector<const MateInfo *> &pool) {
+    auto total = 0;
+    for (auto mateInfo : pool) {
+        total += mateInfo->matePower;
+    }
+    return total;
+}
+
+int
+offeredMates(const vector<MateInfoRef> &pool) {
+    auto total = 0;
+    for (const auto &mateRef : pool) {
+        total += mateRef.mateInfo->matePower;
+    }
+    return total;
+}
+
+// a count taken from the kept reads of a sample, scaled up to all reads
+// added, but not beyond limit. Without sampling it is the count itself.
+int
+scaleSampled(int sampled, double scale, int limit) {
+    if (scale == 1.0) {
+        return sampled;
+    }
+    return min(limit, static_cast<int>(round(sampled * scale)));
+}
+
+} // namespace
+
+int
+Breakpoint::addSoftAlignment(shared_ptr<Alignment> alignmentIn,
+                             bool sampling) {
+    auto retained = getRetainedAlignments();
     if (!alignmentIn->isSupplementary()) {
-        if (supportingSoftAlignments.size() <= MAXPERMISSIBLESOFTCLIPS) {
+        ++softAlignmentCount;
+        if (supportingSoftAlignments.size() <= MAXPERMISSIBLESOFTCLIPS &&
+            !(sampling && supportingSoftAlignments.size() >= SAMPLEDCLIPS)) {
             supportingSoftAlignments.push_back(alignmentIn);
+        } else if (sampling) {
+            softSampled = true;
+            sampleIntoReservoir(supportingSoftAlignments, move(alignmentIn),
+                                pos, softAlignmentCount);
         }
     }
+    return getRetainedAlignments() - retained;
 }
 
-void
-Breakpoint::addHardAlignment(shared_ptr<Alignment> alignmentIn) {
+int
+Breakpoint::addHardAlignment(shared_ptr<Alignment> alignmentIn,
+                             bool sampling) {
+    auto retained = getRetainedAlignments();
     if (alignmentIn->isSupplementary()) {
         if (!(alignmentIn->isLowMapq() || alignmentIn->isNullMapq())) {
-            if (supportingHardAlignments.size() <= MAXPERMISSIBLEHARDCLIPS) {
+            ++hardAlignmentCount;
+            if (supportingHardAlignments.size() <= MAXPERMISSIBLEHARDCLIPS &&
+                !(sampling &&
+                  supportingHardAlignments.size() >= SAMPLEDCLIPS)) {
                 supportingHardAlignments.push_back(alignmentIn);
+            } else if (sampling) {
+                hardSampled = true;
+                sampleIntoReservoir(supportingHardAlignments,
+                                    move(alignmentIn), pos,
+                                    hardAlignmentCount);
             }
         } else {
             if (totalLowMapqHardClips < MAXPERMISSIBLELOWMAPQHARDCLIPS) {
@@ -91,47 +157,76 @@ Breakpoint::addHardAlignment(shared_ptr<Alignment> alignmentIn) {
             }
         }
     }
+    return getRetainedAlignments() - retained;
 }
 
 bool
-Breakpoint::finalizeBreakpoint(
-    const deque<MateInfo> &discordantAlignmentsPool,
-    const deque<MateInfo> &discordantLowQualAlignmentsPool,
-    const deque<MateInfo> &discordantAlignmentCandidatesPool) {
-    auto overhangStr = string();
-    auto eventTotal =
-        unpairedBreaksSoft + unpairedBreaksHard + breaksShortIndel;
-    auto artifactTotal =
-        lowQualBreaksSoft + lowQualSpansSoft + lowQualSpansHard;
+Breakpoint::prepareFinalization(
+    const MatePool &discordantAlignmentsPool,
+    const MatePool &discordantLowQualAlignmentsPool,
+    const MatePool &discordantAlignmentCandidatesPool,
+    BreakpointOutput &output) {
+    eventTotal = unpairedBreaksSoft + unpairedBreaksHard + breaksShortIndel;
+    artifactTotal = lowQualBreaksSoft + lowQualSpansSoft + lowQualSpansHard;
     if ((eventTotal + artifactTotal > 50) &&
         (artifactTotal / (0.0 + eventTotal + artifactTotal)) > 0.85) {
-        ++bpindex;
+        output.takeIndex();
         missingInfoBp = true;
-    } else if (static_cast<int>(supportingSoftAlignments.size()) ==
-                   MAXPERMISSIBLESOFTCLIPS &&
+    } else if (softAlignmentCount == MAXPERMISSIBLESOFTCLIPS &&
                eventTotal + normalSpans + artifactTotal >
                    MAXPERMISSIBLEHARDCLIPS * 20) {
-        ++bpindex;
+        output.takeIndex();
         missingInfoBp = true;
     } else {
         fillMatePool(discordantAlignmentsPool, discordantLowQualAlignmentsPool,
                      discordantAlignmentCandidatesPool);
         if (eventTotal < BPSUPPORTTHRESHOLD &&
-            static_cast<int>(poolLeft.size()) < BPSUPPORTTHRESHOLD &&
-            static_cast<int>(poolLowQualLeft.size()) < BPSUPPORTTHRESHOLD &&
-            static_cast<int>(poolRight.size()) < BPSUPPORTTHRESHOLD &&
-            static_cast<int>(poolLowQualRight.size()) < BPSUPPORTTHRESHOLD) {
+            offeredMates(poolLeft) < BPSUPPORTTHRESHOLD &&
+            offeredMates(poolLowQualLeft) < BPSUPPORTTHRESHOLD &&
+            offeredMates(poolRight) < BPSUPPORTTHRESHOLD &&
+            offeredMates(poolLowQualRight) < BPSUPPORTTHRESHOLD) {
             if (artifactTotal < normalSpans) {
                 return false;
             } else {
-                ++bpindex;
+                output.takeIndex();
                 missingInfoBp = true;
             }
         } else {
-            overhangStr = finalizeOverhangs();
-            detectDoubleSupportSupps();
-            collectMateSupport();
+            overhangIndex = output.takeIndex();
+        }
+    }
+    return true;
+}
+
+void
+Breakpoint::detachFromPools(
+    const MatePool &discordantAlignmentsPool,
+    const MatePool &discordantLowQualAlignmentsPool) {
+    discordantAlignmentsPool.pinChunks(pinnedChunks);
+    discordantLowQualAlignmentsPool.pinChunks(pinnedChunks);
+    // a read clipped at both ends supports two breakpoints, which would both
+    // set its chosen breakpoint
+    auto detachShared = [](vector<shared_ptr<Alignment>> &alignments,
+                           char clipType) {
+        for (auto &alignment : alignments) {
+            const auto &types = alignment->getReadBreakpointTypes();
+            if (count(types.cbegin(), types.cend(), clipType) > 1) {
+                alignment = alignment->clone();
+            }
         }
+    };
+    detachShared(supportingSoftAlignments, 'S');
+    detachShared(supportingHardAlignments, 'H');
+    detachShared(supportingHardLowMapqAlignments, 'H');
+}
+
+bool
+Breakpoint::completeFinalization(string &report) {
+    auto overhangStr = string();
+    if (overhangIndex != 0) {
+        overhangStr = finalizeOverhangs(overhangIndex);
+        detectDoubleSupportSupps();
+        collectMateSupport();
     }
     if (eventTotal + mateSupport + artifactTotal < BPSUPPORTTHRESHOLD ||
         (eventTotal + artifactTotal < BPSUPPORTTHRESHOLD &&
@@ -155,12 +250,12 @@ Breakpoint::finalizeBreakpoint(
             return false;
         }
     }
-    printBreakpointReport(overhangStr);
+    report = printBreakpointReport(overhangStr);
     return true;
 }
 
-void
-Breakpoint::printBreakpointReport(const string &overhangStr) {
+string
+Breakpoint::printBreakpointReport(const string &overhangStr) const {
     string res{};
     res.reserve(350);
     res.append(ChrConverter::indexToChr[chrIndex]).append("\t");
@@ -198,7 +293,7 @@ Breakpoint::printBreakpointReport(const string &overhangStr) {
             res.append(overhangStr).append("\n");
         }
     }
-    cout << res;
+    return res;
 }
 
 void
@@ -215,8 +310,11 @@ Breakpoint::collapseSuppRange(string &res,
 }
 
 string
-Breakpoint::finalizeOverhangs() {
-    ++bpindex;
+Breakpoint::finalizeOverhangs(int index) {
+    if (softSampled) {
+        softSampleScale =
+            softAlignmentCount / (0.0 + supportingSoftAlignments.size());
+    }
     for (auto i = 0u; i < supportingSoftAlignments.size(); ++i) {
         supportingSoftAlignments[i]->setChosenBp(pos, i);
         if (supportingSoftAlignments[i]->assessOutlierMateDistance()) {
@@ -224,36 +322,18 @@ Breakpoint::finalizeOverhangs() {
                 if (supportingSoftAlignments[i]->isOverhangEncounteredM()) {
                     if (!(supportingSoftAlignments[i]->isNullMapq() ||
                           supportingSoftAlignments[i]->isLowMapq())) {
-                        poolLeft.emplace_back(
-                            supportingSoftAlignments[i]->getStartPos(),
-                            supportingSoftAlignments[i]->getEndPos(),
-                            supportingSoftAlignments[i]->getMateChrIndex(),
-                            supportingSoftAlignments[i]->getMatePos(), 0,
-                            supportingSoftAlignments[i]->isInvertedMate());
+                        addOwnMate(poolLeft, *supportingSoftAlignments[i], 0);
                     } else {
-                        poolLowQualLeft.emplace_back(
-                            supportingSoftAlignments[i]->getStartPos(),
-                            supportingSoftAlignments[i]->getEndPos(),
-                            supportingSoftAlignments[i]->getMateChrIndex(),
-                            supportingSoftAlignments[i]->getMatePos(), 0,
-                            supportingSoftAlignments[i]->isInvertedMate());
+                        addOwnMate(poolLowQualLeft,
+                                   *supportingSoftAlignments[i], 0);
                     }
                 } else {
                     if (!(supportingSoftAlignments[i]->isNullMapq() ||
                           supportingSoftAlignments[i]->isLowMapq())) {
-                        poolRight.emplace_back(
-                            supportingSoftAlignments[i]->getStartPos(),
-                            supportingSoftAlignments[i]->getEndPos(),
-                            supportingSoftAlignments[i]->getMateChrIndex(),
-                            supportingSoftAlignments[i]->getMatePos(), 0,
-                            supportingSoftAlignments[i]->isInvertedMate());
+                        addOwnMate(poolRight, *supportingSoftAlignments[i], 0);
                     } else {
-                        poolLowQualRight.emplace_back(
-                            supportingSoftAlignments[i]->getStartPos(),
-                            supportingSoftAlignments[i]->getEndPos(),
-                            supportingSoftAlignments[i]->getMateChrIndex(),
-                            supportingSoftAlignments[i]->getMatePos(), 0,
-                            supportingSoftAlignments[i]->isInvertedMate());
+                        addOwnMate(poolLowQualRight,
+                                   *supportingSoftAlignments[i], 0);
                     }
                 }
             }
@@ -264,14 +344,23 @@ Breakpoint::finalizeOverhangs() {
          [](const shared_ptr<Alignment> &a, const shared_ptr<Alignment> &b) {
              return a->getOverhangLength() < b->getOverhangLength();
          });
+    // every overhang is packed once, and then compared to all parents
+    vector<PackedOverhang> packedOverhangs{};
+    packedOverhangs.reserve(supportingSoftAlignments.size());
+    for (const auto &alignment : supportingSoftAlignments) {
+        packedOverhangs.emplace_back(*alignment);
+    }
     vector<shared_ptr<Alignment>> supportingSoftParentAlignments{};
+    vector<PackedOverhang> packedParentOverhangs{};
+    auto repetitiveOverhangs = 0;
     while (!supportingSoftAlignments.empty()) {
         auto substrCheck = false;
         auto tmpSas = supportingSoftAlignments.back()->generateSuppAlignments(
-            chrIndex, pos);
-        for (auto overhangParent : supportingSoftParentAlignments) {
-            if (matchDetector(overhangParent,
-                              supportingSoftAlignments.back())) {
+            chrIndex, pos, *readParameters);
+        for (auto j = 0u; j < supportingSoftParentAlignments.size(); ++j) {
+            const auto &overhangParent = supportingSoftParentAlignments[j];
+            if (matchDetector(packedParentOverhangs[j],
+                              packedOverhangs.back())) {
                 substrCheck = true;
                 overhangParent->addChildNode(
                     supportingSoftAlignments.back()->getOriginIndex());
@@ -291,6 +380,8 @@ Breakpoint::finalizeOverhangs() {
                         tmpSas);
                     supportingSoftParentAlignments.push_back(
                         supportingSoftAlignments.back());
+                    packedParentOverhangs.push_back(
+                        move(packedOverhangs.back()));
                 } else {
                     for (const auto &sa : tmpSas) {
                         auto it =
@@ -320,17 +411,21 @@ Breakpoint::finalizeOverhangs() {
                     }
                 }
             } else {
-                --unpairedBreaksSoft;
-                ++repetitiveOverhangBreaks;
+                ++repetitiveOverhangs;
             }
         }
         supportingSoftAlignments.pop_back();
+        packedOverhangs.pop_back();
     }
+    repetitiveOverhangs = scaleSampled(repetitiveOverhangs, softSampleScale,
+                                       unpairedBreaksSoft);
+    unpairedBreaksSoft -= repetitiveOverhangs;
+    repetitiveOverhangBreaks += repetitiveOverhangs;
     string consensusOverhangsTmp{};
     consensusOverhangsTmp.reserve(250);
     {
         auto i = 1;
-        auto indexStr = strtk::type_to_string<int>(bpindex);
+        auto indexStr = strtk::type_to_string<int>(index);
         for (const auto &overhangParent : supportingSoftParentAlignments) {
             if (static_cast<int>(overhangParent->getChildrenNodes().size()) >=
                 BPSUPPORTTHRESHOLD) {
@@ -403,59 +498,22 @@ Breakpoint::finalizeOverhangs() {
 }
 
 bool
-Breakpoint::matchDetector(const shared_ptr<Alignment> &longAlignment,
-                          const shared_ptr<Alignment> &shortAlignment) const {
-    if (longAlignment->isOverhangEncounteredM() !=
-        shortAlignment->isOverhangEncounteredM()) {
+Breakpoint::matchDetector(const PackedOverhang &longOverhang,
+                          const PackedOverhang &shortOverhang) const {
+    if (longOverhang.isEncounteredM() != shortOverhang.isEncounteredM()) {
         return false;
     }
-    auto mismatches = 0;
-    char cLong{};
-    char cShort{};
-    auto shortS = shortAlignment->getOverhangLength();
-    auto longStart = longAlignment->getOverhangStartIndex();
-    auto shortStart = shortAlignment->getOverhangStartIndex();
-    const auto pointerToLongSeq = &longAlignment->getSamLine();
-    const auto pointerToShortSeq = &shortAlignment->getSamLine();
-    if (!longAlignment->isOverhangEncounteredM() &&
-        !shortAlignment->isOverhangEncounteredM()) {
-        auto lenDiff = longAlignment->getOverhangLength() - shortS;
-        for (int i = shortS - 1; i >= 0; --i) {
-            cLong = (*pointerToLongSeq)[longStart + i + lenDiff];
-            if (cLong == 'N')
-                continue;
-            cShort = (*pointerToShortSeq)[shortStart + i];
-            if (cShort == 'N')
-                continue;
-            if (cLong != cShort) {
-                ++mismatches;
-                if (mismatches > PERMISSIBLEMISMATCHES)
-                    return false;
-            }
-        }
-        return true;
-    } else if (longAlignment->isOverhangEncounteredM() &&
-               shortAlignment->isOverhangEncounteredM()) {
-        for (auto i = 0; i < shortS; ++i) {
-            cLong = (*pointerToLongSeq)[longStart + i];
-            if (cLong == 'N')
-                continue;
-            cShort = (*pointerToShortSeq)[shortStart + i];
-            if (cShort == 'N')
-                continue;
-            if (cLong != cShort) {
-                ++mismatches;
-                if (mismatches > PERMISSIBLEMISMATCHES)
-                    return false;
-            }
-        }
-        return true;
-    }
-    return false;
+    return longOverhang.countMismatches(shortOverhang,
+                                        PERMISSIBLEMISMATCHES) <=
+           PERMISSIBLEMISMATCHES;
 }
 
 void
 Breakpoint::detectDoubleSupportSupps() {
+    if (hardSampled) {
+        hardSampleScale =
+            hardAlignmentCount / (0.0 + supportingHardAlignments.size());
+    }
     vector<SuppAlignment> saHardTmpLowQual;
     {
         auto i = 0u;
@@ -464,7 +522,8 @@ Breakpoint::detectDoubleSupportSupps() {
         }
         for (auto hardAlignment : supportingHardAlignments) {
             for (const auto &sa :
-                 hardAlignment->generateSuppAlignments(chrIndex, pos)) {
+                 hardAlignment->generateSuppAlignments(chrIndex, pos,
+                                                      *readParameters)) {
                 if (!(sa.isInverted() && sa.getPos() == pos &&
                       sa.getChrIndex() == chrIndex)) {
                     supplementsSecondary.push_back(sa);
@@ -472,37 +531,17 @@ Breakpoint::detectDoubleSupportSupps() {
                         if (supplementsSecondary.back().isEncounteredM()) {
                             if (!(hardAlignment->isNullMapq() ||
                                   hardAlignment->isLowMapq())) {
-                                poolLeft.emplace_back(
-                                    hardAlignment->getStartPos(),
-                                    hardAlignment->getEndPos(),
-                                    hardAlignment->getMateChrIndex(),
-                                    hardAlignment->getMatePos(), 1,
-                                    hardAlignment->isInvertedMate());
+                                addOwnMate(poolLeft, *hardAlignment, 1);
                             } else {
-                                poolLowQualLeft.emplace_back(
-                                    hardAlignment->getStartPos(),
-                                    hardAlignment->getEndPos(),
-                                    hardAlignment->getMateChrIndex(),
-                                    hardAlignment->getMatePos(), 1,
-                                    hardAlignment->isInvertedMate());
+                                addOwnMate(poolLowQualLeft, *hardAlignment, 1);
                             }
 
                         } else {
                             if (!(hardAlignment->isNullMapq() ||
                                   hardAlignment->isLowMapq())) {
-                                poolRight.emplace_back(
-                                    hardAlignment->getStartPos(),
-                                    hardAlignment->getEndPos(),
-                                    hardAlignment->getMateChrIndex(),
-                                    hardAlignment->getMatePos(), 1,
-                                    hardAlignment->isInvertedMate());
+                                addOwnMate(poolRight, *hardAlignment, 1);
                             } else {
-                                poolLowQualRight.emplace_back(
-                                    hardAlignment->getStartPos(),
-                                    hardAlignment->getEndPos(),
-                                    hardAlignment->getMateChrIndex(),
-                                    hardAlignment->getMatePos(), 1,
-                                    hardAlignment->isInvertedMate());
+                                addOwnMate(poolLowQualRight, *hardAlignment, 1);
                             }
                         }
                     }
@@ -516,25 +555,16 @@ Breakpoint::detectDoubleSupportSupps() {
 
         for (auto hardAlignment : supportingHardLowMapqAlignments) {
             for (const auto &sa :
-                 hardAlignment->generateSuppAlignments(chrIndex, pos)) {
+                 hardAlignment->generateSuppAlignments(chrIndex, pos,
+                                                      *readParameters)) {
                 if (!(sa.isInverted() && sa.getPos() == pos &&
                       sa.getChrIndex() == chrIndex)) {
                     saHardTmpLowQual.push_back(sa);
                     if (saHardTmpLowQual.back().isDistant()) {
                         if (saHardTmpLowQual.back().isEncounteredM()) {
-                            poolLowQualLeft.emplace_back(
-                                hardAlignment->getStartPos(),
-                                hardAlignment->getEndPos(),
-                                hardAlignment->getMateChrIndex(),
-                                hardAlignment->getMatePos(), 1,
-                                hardAlignment->isInvertedMate());
+                            addOwnMate(poolLowQualLeft, *hardAlignment, 1);
                         } else {
-                            poolLowQualRight.emplace_back(
-                                hardAlignment->getStartPos(),
-                                hardAlignment->getEndPos(),
-                                hardAlignment->getMateChrIndex(),
-                                hardAlignment->getMatePos(), 1,
-                                hardAlignment->isInvertedMate());
+                            addOwnMate(poolLowQualRight, *hardAlignment, 1);
                         }
                     }
                 }
@@ -647,14 +677,16 @@ Breakpoint::detectDoubleSupportSupps() {
          uniqueDoubleSupportPrimaryIndices.end());
     sort(uniqueDoubleSupportSecondaryIndices.begin(),
          uniqueDoubleSupportSecondaryIndices.end());
-    auto priCompensation =
+    auto priCompensation = scaleSampled(
         distance(uniqueDoubleSupportPrimaryIndices.begin(),
                  unique(uniqueDoubleSupportPrimaryIndices.begin(),
-                        uniqueDoubleSupportPrimaryIndices.end()));
-    auto secCompensation =
+                        uniqueDoubleSupportPrimaryIndices.end())),
+        softSampleScale, unpairedBreaksSoft);
+    auto secCompensation = scaleSampled(
         distance(uniqueDoubleSupportSecondaryIndices.begin(),
                  unique(uniqueDoubleSupportSecondaryIndices.begin(),
-                        uniqueDoubleSupportSecondaryIndices.end()));
+                        uniqueDoubleSupportSecondaryIndices.end())),
+        hardSampleScale, unpairedBreaksHard);
     unpairedBreaksSoft -= priCompensation;
     unpairedBreaksHard -= secCompensation;
     pairedBreaksSoft += priCompensation;
@@ -662,15 +694,20 @@ Breakpoint::detectDoubleSupportSupps() {
 }
 void
 Breakpoint::collectMateSupport() {
-    sort(poolLeft.begin(), poolLeft.end());
-    sort(poolRight.begin(), poolRight.end());
-    compressMatePool(poolLeft);
-    compressMatePool(poolRight);
+    // only the clusters are copied from the pools, in sorted order
+    auto mateOrder = [](const MateInfo *lhs, const MateInfo *rhs) {
+        return *lhs < *rhs;
+    };
+    sort(poolLeft.begin(), poolLeft.end(), mateOrder);
+    sort(poolRight.begin(), poolRight.end(), mateOrder);
+    vector<MateInfo> matesLeft, matesRight;
+    compressMatePool(poolLeft, matesLeft);
+    compressMatePool(poolRight, matesRight);
     auto leftDiscordantsTotal = 0, rightDiscordantsTotal = 0;
-    for (const auto &mateInfo : poolLeft) {
+    for (const auto &mateInfo : matesLeft) {
         leftDiscordantsTotal += mateInfo.matePower;
     }
-    for (const auto &mateInfo : poolRight) {
+    for (const auto &mateInfo : matesRight) {
         rightDiscordantsTotal += mateInfo.matePower;
     }
     auto leftSideExpectedErrors = 0.0;
@@ -693,10 +730,10 @@ Breakpoint::collectMateSupport() {
         if (sa.isDistant()) {
             if (sa.isEncounteredM()) {
                 sa.setExpectedDiscordants(leftDiscordantsTotal);
-                collectMateSupportHelper(sa, poolLeft, poolLowQualLeft);
+                collectMateSupportHelper(sa, matesLeft, poolLowQualLeft);
             } else {
                 sa.setExpectedDiscordants(rightDiscordantsTotal);
-                collectMateSupportHelper(sa, poolRight, poolLowQualRight);
+                collectMateSupportHelper(sa, matesRight, poolLowQualRight);
             }
         }
     }
@@ -704,10 +741,10 @@ Breakpoint::collectMateSupport() {
         if (sa.isDistant()) {
             if (sa.isEncounteredM()) {
                 sa.setExpectedDiscordants(leftDiscordantsTotal);
-                collectMateSupportHelper(sa, poolLeft, poolLowQualLeft);
+                collectMateSupportHelper(sa, matesLeft, poolLowQualLeft);
             } else {
                 sa.setExpectedDiscordants(rightDiscordantsTotal);
-                collectMateSupportHelper(sa, poolRight, poolLowQualRight);
+                collectMateSupportHelper(sa, matesRight, poolLowQualRight);
             }
         } else if (sa.getSupport() < BPSUPPORTTHRESHOLD) {
             sa.setToRemove(true);
@@ -765,10 +802,10 @@ Breakpoint::collectMateSupport() {
         if (sa.isDistant()) {
             if (sa.isEncounteredM()) {
                 sa.setExpectedDiscordants(leftDiscordantsTotal);
-                collectMateSupportHelper(sa, poolLeft, poolLowQualLeft);
+                collectMateSupportHelper(sa, matesLeft, poolLowQualLeft);
             } else {
                 sa.setExpectedDiscordants(rightDiscordantsTotal);
-                collectMateSupportHelper(sa, poolRight, poolLowQualRight);
+                collectMateSupportHelper(sa, matesRight, poolLowQualRight);
             }
             if (sa.getMateSupport() > 0) {
                 doubleSidedMatches.push_back(sa);
@@ -785,30 +822,36 @@ Breakpoint::collectMateSupport() {
     sort(originIndices.begin(), originIndices.end());
     int uniqueCount = unique(originIndices.begin(), originIndices.end()) -
                       originIndices.begin();
-    uniqueCount = min(lowQualBreaksHard, uniqueCount);
+    uniqueCount = min(lowQualBreaksHard,
+                      scaleSampled(uniqueCount, hardSampleScale,
+                                   lowQualBreaksHard));
     lowQualBreaksHard -= uniqueCount;
     lowQualBreaksSoft += uniqueCount;
 
-    for (const auto &mateInfo : poolLeft) {
+    for (const auto &mateInfo : matesLeft) {
         if (!mateInfo.saSupporter && mateInfo.evidenceLevel == 3 &&
             mateInfo.matePower / (0.0 + leftDiscordantsTotal) >= 0.33 &&
-            (pos - mateInfo.readEndPos) < DEFAULTREADLENGTH / 2) {
+            (pos - mateInfo.readEndPos) <
+                readParameters->defaultReadLength / 2) {
             supplementsPrimary.emplace_back(
                 mateInfo.mateChrIndex, mateInfo.mateStartPos,
                 mateInfo.matePower, leftDiscordantsTotal, true,
                 mateInfo.inversionSupport > mateInfo.straightSupport,
-                mateInfo.mateEndPos, false, false, false, -1);
+                mateInfo.mateEndPos, false, false, false, -1,
+                *readParameters);
         }
     }
-    for (const auto &mateInfo : poolRight) {
+    for (const auto &mateInfo : matesRight) {
         if (!mateInfo.saSupporter && mateInfo.evidenceLevel == 3 &&
             mateInfo.matePower / (0.0 + rightDiscordantsTotal) >= 0.33 &&
-            (mateInfo.readStartPos - pos) < DEFAULTREADLENGTH / 2) {
+            (mateInfo.readStartPos - pos) <
+                readParameters->defaultReadLength / 2) {
             supplementsPrimary.emplace_back(
                 mateInfo.mateChrIndex, mateInfo.mateStartPos,
                 mateInfo.matePower, rightDiscordantsTotal, false,
                 mateInfo.inversionSupport > mateInfo.straightSupport,
-                mateInfo.mateEndPos, false, false, false, -1);
+                mateInfo.mateEndPos, false, false, false, -1,
+                *readParameters);
         }
     }
     for (auto &sa : doubleSidedMatches) {
@@ -882,82 +925,80 @@ Breakpoint::collectMateSupport() {
 }
 
 void
-Breakpoint::compressMatePool(vector<MateInfo> &discordantAlignmentsPool) {
-    if (discordantAlignmentsPool.empty())
-        return;
-    auto lastIndex = 0;
-    for (auto i = 1; i < static_cast<int>(discordantAlignmentsPool.size());
-         ++i) {
-        if (discordantAlignmentsPool[lastIndex].mateChrIndex !=
-                discordantAlignmentsPool[i].mateChrIndex ||   //
-            discordantAlignmentsPool[i].mateStartPos -
-                    discordantAlignmentsPool[lastIndex].mateEndPos >
-                3.5 * DEFAULTREADLENGTH) {
-            lastIndex = i;
-        } else {
-            discordantAlignmentsPool[lastIndex].mateEndPos =
-                max(discordantAlignmentsPool[lastIndex].mateEndPos,
-                    discordantAlignmentsPool[i].mateEndPos);
-            discordantAlignmentsPool[lastIndex].mateStartPos =
-                min(discordantAlignmentsPool[lastIndex].mateStartPos,
-                    discordantAlignmentsPool[i].mateStartPos);
-            ++discordantAlignmentsPool[lastIndex].matePower;
-            if (discordantAlignmentsPool[i].inverted) {
-                ++discordantAlignmentsPool[lastIndex].inversionSupport;
-            } else {
-                ++discordantAlignmentsPool[lastIndex].straightSupport;
-            }
-            if (abs(pos - discordantAlignmentsPool[i].readStartPos) <=
-                abs(pos - discordantAlignmentsPool[i].readEndPos)) {
-                // left side
-                if (abs(pos - discordantAlignmentsPool[lastIndex].readEndPos) >
-                    abs(pos - discordantAlignmentsPool[i].readEndPos)) {
-                    discordantAlignmentsPool[lastIndex].readStartPos =
-                        discordantAlignmentsPool[i].readStartPos;
-                    discordantAlignmentsPool[lastIndex].readEndPos =
-                        discordantAlignmentsPool[i].readEndPos;
-                }
-            } else {
-                // right side
-                if (abs(pos -
-                        discordantAlignmentsPool[lastIndex].readStartPos) >
-                    abs(pos - discordantAlignmentsPool[i].readStartPos)) {
-                    discordantAlignmentsPool[lastIndex].readStartPos =
-                        discordantAlignmentsPool[i].readStartPos;
-                    discordantAlignmentsPool[lastIndex].readEndPos =
-                        discordantAlignmentsPool[i].readEndPos;
-                }
-            }
-            if ((discordantAlignmentsPool[lastIndex].source == 0 &&
-                 discordantAlignmentsPool[i].source == 1) ||
-                (discordantAlignmentsPool[lastIndex].source == 1 &&
-                 discordantAlignmentsPool[i].source == 0)) {
-                discordantAlignmentsPool[lastIndex].evidenceLevel = 2;
-                discordantAlignmentsPool[lastIndex].source = 2;
+Breakpoint::compressMatePool(const vector<const MateInfo *> &mates,
+                             vector<MateInfo> &clusters) const {
+    // the index of the first mate of each cluster
+    vector<size_t> firstMates{};
+    for (auto i = 0u; i < mates.size(); ++i) {
+        const auto &mateInfo = *mates[i];
+        if (clusters.empty() ||
+            clusters.back().mateChrIndex != mateInfo.mateChrIndex || //
+            mateInfo.mateStartPos - clusters.back().mateEndPos >
+                3.5 * readParameters->defaultReadLength) {
+            clusters.push_back(mateInfo);
+            firstMates.push_back(i);
+            continue;
+        }
+        auto &cluster = clusters.back();
+        cluster.mateEndPos = max(cluster.mateEndPos, mateInfo.mateEndPos);
+        cluster.mateStartPos = min(cluster.mateStartPos, mateInfo.mateStartPos);
+        cluster.matePower += mateInfo.matePower;
+        cluster.inversionSupport += mateInfo.inversionSupport;
+        cluster.straightSupport += mateInfo.straightSupport;
+        if (abs(pos - mateInfo.readStartPos) <=
+            abs(pos - mateInfo.readEndPos)) {
+            // left side
+            if (abs(pos - cluster.readEndPos) >
+                abs(pos - mateInfo.readEndPos)) {
+                cluster.readStartPos = mateInfo.readStartPos;
+                cluster.readEndPos = mateInfo.readEndPos;
             }
-            if (discordantAlignmentsPool[lastIndex].evidenceLevel != 3 &&
-                discordantAlignmentsPool[i].evidenceLevel == 3) {
-                discordantAlignmentsPool[lastIndex].evidenceLevel = 3;
-                discordantAlignmentsPool[lastIndex].source = 2;
+        } else {
+            // right side
+            if (abs(pos - cluster.readStartPos) >
+                abs(pos - mateInfo.readStartPos)) {
+                cluster.readStartPos = mateInfo.readStartPos;
+                cluster.readEndPos = mateInfo.readEndPos;
             }
-            discordantAlignmentsPool[i].toRemove = true;
+        }
+        if ((cluster.source == 0 && mateInfo.source == 1) ||
+            (cluster.source == 1 && mateInfo.source == 0)) {
+            cluster.evidenceLevel = 2;
+            cluster.source = 2;
+        }
+        if (cluster.evidenceLevel != 3 && mateInfo.evidenceLevel == 3) {
+            cluster.evidenceLevel = 3;
+            cluster.source = 2;
         }
     }
-
-    for (auto &cluster : discordantAlignmentsPool) {
-        if (cluster.evidenceLevel == 1 &&
-            cluster.matePower < BPSUPPORTTHRESHOLD) {
-            cluster.toRemove = true;
+    // The clusters are output in the order that cleanUpVector left them in
+    // when the mates were compressed in place: each gap, left by a merged
+    // mate or a weak cluster, is filled with the last cluster kept.
+    vector<size_t> kept{};
+    for (auto i = 0u; i < clusters.size(); ++i) {
+        if (!(clusters[i].evidenceLevel == 1 &&
+              clusters[i].matePower < BPSUPPORTTHRESHOLD)) {
+            kept.push_back(i);
         }
     }
-    cleanUpVector(discordantAlignmentsPool);
+    vector<MateInfo> ordered{};
+    ordered.reserve(kept.size());
+    auto first = kept.begin(), last = kept.end();
+    while (first != last) {
+        if (firstMates[*first] == ordered.size()) {
+            ordered.push_back(clusters[*first++]);
+        } else {
+            ordered.push_back(clusters[*--last]);
+        }
+    }
+    clusters.swap(ordered);
 }
 
 void
 Breakpoint::fillMatePool(
-    const deque<MateInfo> &discordantAlignmentsPool,
-    const deque<MateInfo> &discordantLowQualAlignmentsPool,
-    const deque<MateInfo> &discordantAlignmentCandidatesPool) {
+    const MatePool &discordantAlignmentsPool,
+    const MatePool &discordantLowQualAlignmentsPool,
+    const MatePool &discordantAlignmentCandidatesPool) {
     poolLeft.reserve(discordantAlignmentsPool.size());
     poolRight.reserve(discordantAlignmentsPool.size());
     {
@@ -967,15 +1008,15 @@ Breakpoint::fillMatePool(
                 break;
             } else {
                 if (discordantAlignmentsPool[i].readEndPos <= pos) {
-                    poolLeft.push_back(discordantAlignmentsPool[i]);
+                    poolLeft.push_back(&discordantAlignmentsPool[i]);
                 } else {
-                    poolLeft.push_back(discordantAlignmentsPool[i]);
-                    poolRight.push_back(discordantAlignmentsPool[i]);
+                    poolLeft.push_back(&discordantAlignmentsPool[i]);
+                    poolRight.push_back(&discordantAlignmentsPool[i]);
                 }
             }
         }
         for (; i < discordantAlignmentsPool.size(); ++i) {
-            poolRight.push_back(discordantAlignmentsPool[i]);
+            poolRight.push_back(&discordantAlignmentsPool[i]);
         }
     }
     if (PROPERPAIRCOMPENSATIONMODE) {
@@ -984,16 +1025,16 @@ Breakpoint::fillMatePool(
             if (discordantAlignmentCandidatesPool[i].readStartPos >= pos) {
                 break;
             } else {
-                if (discordantAlignmentCandidatesPool[i].readEndPos <= pos) {
-                    ++leftSideDiscordantCandidates;
-                } else {
-                    ++leftSideDiscordantCandidates;
-                    ++rightSideDiscordantCandidates;
+                const auto &mateInfo = discordantAlignmentCandidatesPool[i];
+                leftSideDiscordantCandidates += mateInfo.matePower;
+                if (mateInfo.readEndPos > pos) {
+                    rightSideDiscordantCandidates += mateInfo.matePower;
                 }
             }
         }
         for (; i < discordantAlignmentCandidatesPool.size(); ++i) {
-            ++rightSideDiscordantCandidates;
+            rightSideDiscordantCandidates +=
+                discordantAlignmentCandidatesPool[i].matePower;
         }
     }
     poolLowQualLeft.reserve(discordantLowQualAlignmentsPool.size());
@@ -1002,37 +1043,79 @@ Breakpoint::fillMatePool(
         auto i = 0u;
         for (; i < discordantLowQualAlignmentsPool.size(); ++i) {
             if (discordantLowQualAlignmentsPool[i].readStartPos <
-                pos - DISCORDANTLOWQUALLEFTRANGE) {
+                pos - readParameters->discordantLowQualLeftRange) {
                 continue;
             }
             if (discordantLowQualAlignmentsPool[i].readStartPos >= pos) {
                 break;
             } else {
-                if (discordantLowQualAlignmentsPool[i].readEndPos <= pos) {
-                    poolLowQualLeft.push_back(
-                        discordantLowQualAlignmentsPool[i]);
-                } else {
-                    poolLowQualLeft.push_back(
-                        discordantLowQualAlignmentsPool[i]);
-                    poolLowQualRight.push_back(
-                        discordantLowQualAlignmentsPool[i]);
+                const auto &mateInfo = discordantLowQualAlignmentsPool[i];
+                MateInfoRef mateRef{
+                    &mateInfo,
+                    discordantLowQualAlignmentsPool.hasBpLoc(mateInfo, pos),
+                    false};
+                poolLowQualLeft.push_back(mateRef);
+                if (mateInfo.readEndPos > pos) {
+                    poolLowQualRight.push_back(mateRef);
                 }
             }
         }
         for (; i < discordantLowQualAlignmentsPool.size(); ++i) {
             if (discordantLowQualAlignmentsPool[i].readStartPos >
-                pos + DISCORDANTLOWQUALRIGHTRANGE) {
+                pos + readParameters->discordantLowQualRightRange) {
                 break;
             }
-            poolLowQualRight.push_back(discordantLowQualAlignmentsPool[i]);
+            const auto &mateInfo = discordantLowQualAlignmentsPool[i];
+            poolLowQualRight.push_back(MateInfoRef{
+                &mateInfo,
+                discordantLowQualAlignmentsPool.hasBpLoc(mateInfo, pos),
+                false});
         }
     }
 }
 
+void
+Breakpoint::weighOwnMate(MateInfo &mateInfo, const Alignment &alignment,
+                         int source) const {
+    auto scale = softSampleScale;
+    if (source != 0) {
+        // the low mapq hard clipped reads are never sampled
+        scale = alignment.isLowMapq() || alignment.isNullMapq()
+                    ? 1.0
+                    : hardSampleScale;
+    }
+    if (scale == 1.0) {
+        return;
+    }
+    mateInfo.matePower = static_cast<int>(round(scale));
+    mateInfo.inversionSupport = mateInfo.inverted ? mateInfo.matePower : 0;
+    mateInfo.straightSupport = mateInfo.inverted ? 0 : mateInfo.matePower;
+}
+
+void
+Breakpoint::addOwnMate(vector<const MateInfo *> &pool,
+                       const Alignment &alignment, int source) {
+    ownMates.emplace_back(alignment.getStartPos(), alignment.getEndPos(),
+                          alignment.getMateChrIndex(), alignment.getMatePos(),
+                          source, alignment.isInvertedMate());
+    weighOwnMate(ownMates.back(), alignment, source);
+    pool.push_back(&ownMates.back());
+}
+
+void
+Breakpoint::addOwnMate(vector<MateInfoRef> &pool, const Alignment &alignment,
+                       int source) {
+    ownMates.emplace_back(alignment.getStartPos(), alignment.getEndPos(),
+                          alignment.getMateChrIndex(), alignment.getMatePos(),
+                          source, alignment.isInvertedMate());
+    weighOwnMate(ownMates.back(), alignment, source);
+    pool.push_back(MateInfoRef{&ownMates.back(), false, false});
+}
+
 void
 Breakpoint::collectMateSupportHelper(
     SuppAlignment &sa, vector<MateInfo> &discordantAlignmentsPool,
-    vector<MateInfo> &discordantLowQualAlignmentsPool) {
+    vector<MateInfoRef> &discordantLowQualAlignmentsPool) {
     auto maxEvidenceLevel = 0;
     for (auto &mateInfo : discordantAlignmentsPool) {
         if (mateInfo.suppAlignmentFuzzyMatch(sa)) {
@@ -1051,22 +1134,16 @@ Breakpoint::collectMateSupportHelper(
         }
     }
     int lowQualSupports{0};
-    for (auto &mateInfo : discordantLowQualAlignmentsPool) {
+    for (auto &mateRef : discordantLowQualAlignmentsPool) {
+        const auto &mateInfo = *mateRef.mateInfo;
         if (mateInfo.suppAlignmentFuzzyMatch(sa)) {
-            if (!mateInfo.saSupporter) {
-                mateSupport += 1;
-                mateInfo.saSupporter = true;
-            }
-            sa.incrementMateSupport(1);
-            ++lowQualSupports;
-            auto bpPosMatch = false;
-            for (const auto bpPos : mateInfo.bpLocs) {
-                if (bpPos == pos) {
-                    bpPosMatch = true;
-                    break;
-                }
+            if (!mateRef.saSupporter) {
+                mateSupport += mateInfo.matePower;
+                mateRef.saSupporter = true;
             }
-            if (!bpPosMatch) {
+            sa.incrementMateSupport(mateInfo.matePower);
+            lowQualSupports += mateInfo.matePower;
+            if (!mateRef.bpPosMatch) {
                 if (mateInfo.evidenceLevel > maxEvidenceLevel) {
                     maxEvidenceLevel = mateInfo.evidenceLevel;
                 }
@@ -1076,8 +1153,7 @@ Breakpoint::collectMateSupportHelper(
     auto lowQualDiscordantSupports =
         lowQualSupports +
         min(lowQualSupports,
-            static_cast<int>(discordantLowQualAlignmentsPool.size()) -
-                lowQualSupports);
+            offeredMates(discordantLowQualAlignmentsPool) - lowQualSupports);
     sa.setExpectedDiscordants(sa.getExpectedDiscordants() +
                               lowQualDiscordantSupports);
     if (sa.getMateSupport() == 0) {
@@ -1104,12 +1180,13 @@ Breakpoint::collectMateSupportHelper(
 }
 
 Breakpoint::Breakpoint(const string &bpIn, bool ignoreOverhang)
-    : covFinalized{true}, missingInfoBp{false}, chrIndex{0}, pos{0},
-      normalSpans{0}, lowQualSpansSoft{0}, lowQualSpansHard{0},
-      unpairedBreaksSoft{0}, unpairedBreaksHard{0}, breaksShortIndel{0},
-      lowQualBreaksSoft{0}, lowQualBreaksHard{0}, repetitiveOverhangBreaks{0},
-      pairedBreaksSoft{0}, pairedBreaksHard{0}, mateSupport{0}, leftCoverage{0},
-      rightCoverage{0}, hitsInMref{0}, germline{false} {
+    : readParameters{nullptr}, covFinalized{true}, missingInfoBp{false},
+      chrIndex{0}, pos{0}, normalSpans{0}, lowQualSpansSoft{0},
+      lowQualSpansHard{0}, unpairedBreaksSoft{0}, unpairedBreaksHard{0},
+      breaksShortIndel{0}, lowQualBreaksSoft{0}, lowQualBreaksHard{0},
+      repetitiveOverhangBreaks{0}, pairedBreaksSoft{0}, pairedBreaksHard{0},
+      mateSupport{0}, leftCoverage{0}, rightCoverage{0}, hitsInMref{0},
+      germline{false} {
     auto index = 0;
     vector<int> bpChunkPositions{};
     bpChunkPositions.reserve(7);
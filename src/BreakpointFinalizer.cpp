@@ -0,0 +1,133 @@
+/*
+ * BreakpointFinalizer.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "BreakpointFinalizer.h"
+#include <algorithm>
+
+namespace sophia {
+
+using namespace std;
+
+BreakpointFinalizer::BreakpointFinalizer(int threadsIn,
+                                         BreakpointOutput &outputIn)
+    : THREADS{max(1, threadsIn)},
+      MAXPENDINGJOBS{16 * static_cast<size_t>(THREADS)}, output{outputIn},
+      pendingJobs{}, workQueue{}, shuttingDown{false}, threadPool{} {
+    if (THREADS > 1) {
+        for (auto i = 0; i < THREADS; ++i) {
+            threadPool.emplace_back(&BreakpointFinalizer::workerLoop, this);
+        }
+    }
+}
+
+BreakpointFinalizer::~BreakpointFinalizer() {
+    {
+        lock_guard<mutex> lock{queueMutex};
+        shuttingDown = true;
+    }
+    workAvailable.notify_all();
+    for (auto &worker : threadPool) {
+        worker.join();
+    }
+}
+
+unsigned int
+BreakpointFinalizer::submit(
+    Breakpoint &breakpoint, const MatePool &discordantAlignmentsPool,
+    const MatePool &discordantLowQualAlignmentsPool) {
+    // breakpoints without overhangs to finalize are cheap, and still refer
+    // to the pools, so they are finished right away
+    if (THREADS == 1 ||
+        (pendingJobs.empty() && !breakpoint.hasOverhangIndex())) {
+        auto report = string();
+        if (!breakpoint.completeFinalization(report)) {
+            return 0u;
+        }
+        output.write(report);
+        return 1u;
+    }
+    pendingJobs.push_back(make_unique<Job>(move(breakpoint)));
+    auto &job = *pendingJobs.back();
+    if (!job.breakpoint.hasOverhangIndex()) {
+        job.reported = job.breakpoint.completeFinalization(job.report);
+        job.done = true;
+    } else {
+        job.breakpoint.detachFromPools(discordantAlignmentsPool,
+                                       discordantLowQualAlignmentsPool);
+        {
+            lock_guard<mutex> lock{queueMutex};
+            workQueue.push_back(&job);
+        }
+        workAvailable.notify_one();
+    }
+    return writeFinished(MAXPENDINGJOBS);
+}
+
+unsigned int
+BreakpointFinalizer::writeFinished(size_t keptJobs) {
+    auto written = 0u;
+    while (!pendingJobs.empty()) {
+        auto &job = *pendingJobs.front();
+        {
+            unique_lock<mutex> lock{queueMutex};
+            if (!job.done) {
+                if (pendingJobs.size() <= keptJobs) {
+                    break;
+                }
+                jobDone.wait(lock, [&job] { return job.done; });
+            }
+        }
+        if (job.reported) {
+            output.write(job.report);
+            ++written;
+        }
+        pendingJobs.pop_front();
+    }
+    return written;
+}
+
+void
+BreakpointFinalizer::workerLoop() {
+    while (true) {
+        Job *job{nullptr};
+        {
+            unique_lock<mutex> lock{queueMutex};
+            workAvailable.wait(lock, [this] {
+                return !workQueue.empty() || shuttingDown;
+            });
+            if (shuttingDown) {
+                return;
+            }
+            job = workQueue.front();
+            workQueue.pop_front();
+        }
+        auto reported = job->breakpoint.completeFinalization(job->report);
+        {
+            lock_guard<mutex> lock{queueMutex};
+            job->reported = reported;
+            job->done = true;
+        }
+        jobDone.notify_one();
+    }
+}
+
+} /* namespace sophia */
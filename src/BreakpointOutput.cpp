@@ -0,0 +1,72 @@
+/*
+ * BreakpointOutput.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "BreakpointOutput.h"
+#include "strtk.hpp"
+#include <cctype>
+
+namespace sophia {
+
+using namespace std;
+
+BreakpointOutput::BreakpointOutput(bool bufferedIn, ostream &streamIn)
+    : BUFFERED{bufferedIn}, stream{streamIn}, indexCount{0}, writtenBytes{0},
+      buffer{} {}
+
+void
+BreakpointOutput::write(const string &report) {
+    if (BUFFERED) {
+        buffer.append(report);
+    } else {
+        stream << report;
+        writtenBytes += report.size();
+    }
+}
+
+void
+BreakpointOutput::flush(int indexOffset) {
+    if (indexOffset == 0) {
+        stream << buffer;
+        writtenBytes += buffer.size();
+    } else {
+        // '>' only ever starts an overhang id, the other columns are
+        // numbers, chromosome names and bases
+        string shifted{};
+        shifted.reserve(buffer.size() + buffer.size() / 16);
+        for (auto i = 0u; i < buffer.size();) {
+            shifted.push_back(buffer[i]);
+            if (buffer[i++] != '>') {
+                continue;
+            }
+            auto index = 0;
+            for (; i < buffer.size() && isdigit(buffer[i]); ++i) {
+                index = 10 * index + (buffer[i] - '0');
+            }
+            shifted.append(strtk::type_to_string<int>(index + indexOffset));
+        }
+        stream << shifted;
+        writtenBytes += shifted.size();
+    }
+    buffer.clear();
+    buffer.shrink_to_fit();
+}
+
+} /* namespace sophia */
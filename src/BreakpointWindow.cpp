@@ -0,0 +1,130 @@
+/*
+ * BreakpointWindow.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "BreakpointWindow.h"
+
+namespace sophia {
+
+using namespace std;
+
+namespace {
+
+int
+capacityFor(int length) {
+    auto capacity = 256;
+    while (capacity < length) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // namespace
+
+BreakpointWindow::BreakpointWindow(int expectedLength)
+    : INITIALCAPACITY{capacityFor(expectedLength)},
+      mask{INITIALCAPACITY - 1}, firstPos{-1}, lastPos{-1}, count{0},
+      slots(INITIALCAPACITY), farBreakpoints{} {}
+
+Breakpoint &
+BreakpointWindow::findOrAdd(int chrIndex, int pos,
+                            const ReadParameters &readParameters) {
+    if (!farBreakpoints.empty()) {
+        auto far = farBreakpoints.find(pos);
+        if (far != farBreakpoints.end()) {
+            return far->second;
+        }
+    }
+    if (count == 0) {
+        firstPos = pos;
+        lastPos = pos;
+    } else if (pos < firstPos || pos > lastPos) {
+        auto newFirstPos = min(firstPos, pos);
+        auto newLastPos = max(lastPos, pos);
+        auto length = newLastPos - newFirstPos + 1;
+        if (length > MAXCAPACITY) {
+            return farBreakpoints
+                .try_emplace(pos, chrIndex, pos, readParameters)
+                .first->second;
+        }
+        if (length > mask + 1) {
+            grow(length);
+        }
+        firstPos = newFirstPos;
+        lastPos = newLastPos;
+    }
+    auto &slot = slots[pos & mask];
+    if (!slot) {
+        slot.emplace(chrIndex, pos, readParameters);
+        ++count;
+    }
+    return *slot;
+}
+
+void
+BreakpointWindow::popFirst() {
+    if (!farBreakpoints.empty() &&
+        (count == 0 || farBreakpoints.begin()->first < firstPos)) {
+        farBreakpoints.erase(farBreakpoints.begin());
+        return;
+    }
+    slots[firstPos & mask].reset();
+    if (--count == 0) {
+        firstPos = -1;
+        lastPos = -1;
+        return;
+    }
+    do {
+        ++firstPos;
+    } while (!slots[firstPos & mask]);
+}
+
+void
+BreakpointWindow::clear() {
+    if (mask + 1 > INITIALCAPACITY) {
+        vector<optional<Breakpoint>>(INITIALCAPACITY).swap(slots);
+        mask = INITIALCAPACITY - 1;
+    } else if (count != 0) {
+        for (auto pos = firstPos; pos <= lastPos; ++pos) {
+            slots[pos & mask].reset();
+        }
+    }
+    farBreakpoints.clear();
+    firstPos = -1;
+    lastPos = -1;
+    count = 0;
+}
+
+void
+BreakpointWindow::grow(int length) {
+    auto grownMask = capacityFor(length) - 1;
+    vector<optional<Breakpoint>> grown(grownMask + 1);
+    for (auto pos = firstPos; pos <= lastPos; ++pos) {
+        auto &slot = slots[pos & mask];
+        if (slot) {
+            grown[pos & grownMask].emplace(move(*slot));
+        }
+    }
+    slots.swap(grown);
+    mask = grownMask;
+}
+
+} /* namespace sophia */
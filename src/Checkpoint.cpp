@@ -0,0 +1,131 @@
+/*
+ * Checkpoint.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+
+#include "Checkpoint.h"
+#include "ChrConverter.h"
+#include "HelperFunctions.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace sophia {
+
+using namespace std;
+
+Checkpoint::Checkpoint(const string &fileNameIn, const string &inputFileIn)
+    : fileName{fileNameIn}, inputFile{inputFileIn}, lastChrIndex{0},
+      inputOffset{0}, indexCount{0}, outputBytes{0}, finished{false} {}
+
+void
+Checkpoint::load() {
+    ifstream checkpointFile{fileName};
+    if (!checkpointFile) {
+        perror(("Error opening " + fileName).c_str());
+        exit(EXITCODE_IOERROR);
+    }
+    string line;
+    auto fields = 0;
+    while (error_terminating_getline(checkpointFile, line)) {
+        auto tab = line.find('\t');
+        if (tab == string::npos) {
+            formatError("line without a value");
+        }
+        auto key = line.substr(0, tab);
+        auto value = line.substr(tab + 1);
+        if (key == "input") {
+            if (value != inputFile) {
+                formatError("saved for the input " + value);
+            }
+        } else if (key == "lastChromosome") {
+            lastChrIndex = ChrConverter::readChromosomeIndex(
+                (value + '\t').cbegin(), '\t');
+        } else if (key == "inputOffset") {
+            inputOffset = stoull(value);
+        } else if (key == "overhangIndex") {
+            indexCount = stoi(value);
+        } else if (key == "outputBytes") {
+            outputBytes = stoull(value);
+        } else if (key == "finished") {
+            finished = value == "1";
+        } else {
+            formatError("unknown key " + key);
+        }
+        ++fields;
+    }
+    if (fields != 6) {
+        formatError("incomplete");
+    }
+}
+
+void
+Checkpoint::save(int lastChrIndexIn, uint64_t inputOffsetIn, int indexCountIn,
+                 uint64_t outputBytesIn) {
+    lastChrIndex = lastChrIndexIn;
+    inputOffset = inputOffsetIn;
+    indexCount = indexCountIn;
+    outputBytes = outputBytesIn;
+    write();
+}
+
+void
+Checkpoint::saveFinished(int lastChrIndexIn, int indexCountIn,
+                         uint64_t outputBytesIn) {
+    lastChrIndex = lastChrIndexIn;
+    indexCount = indexCountIn;
+    outputBytes = outputBytesIn;
+    finished = true;
+    write();
+}
+
+void
+Checkpoint::write() const {
+    // a run killed while saving leaves the last complete checkpoint behind
+    auto tmpFileName = fileName + ".tmp";
+    {
+        ofstream tmpFile{tmpFileName};
+        tmpFile << "input\t" << inputFile << '\n'
+                << "lastChromosome\t" << ChrConverter::indexToChr[lastChrIndex]
+                << '\n'
+                << "inputOffset\t" << inputOffset << '\n'
+                << "overhangIndex\t" << indexCount << '\n'
+                << "outputBytes\t" << outputBytes << '\n'
+                << "finished\t" << (finished ? 1 : 0) << '\n';
+        tmpFile.close();
+        if (!tmpFile) {
+            perror(("Error writing " + tmpFileName).c_str());
+            exit(EXITCODE_IOERROR);
+        }
+    }
+    if (rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+        perror(("Error replacing " + fileName).c_str());
+        exit(EXITCODE_IOERROR);
+    }
+}
+
+void
+Checkpoint::formatError(const string &reason) const {
+    cerr << "Error reading checkpoint " << fileName << ": " << reason << endl;
+    exit(EXITCODE_IOERROR);
+}
+
+} /* namespace sophia */
@@ -31,6 +31,21 @@ using namespace std;
 
 int ChosenBp::BPSUPPORTTHRESHOLD{};
 
+void
+ChosenBp::assign(char bpTypeIn, int bpSizeIn, bool bpEncounteredMIn,
+                 int overhangStartIndexIn, int overhangLengthIn,
+                 int selfNodeIndexIn) {
+    bpType = bpTypeIn;
+    bpSize = bpSizeIn;
+    bpEncounteredM = bpEncounteredMIn;
+    overhangStartIndex = overhangStartIndexIn;
+    overhangLength = overhangLengthIn;
+    supplementaryAlignments.clear();
+    childrenNodes.clear();
+    childrenNodes.push_back(selfNodeIndexIn);
+    selfNodeIndex = selfNodeIndexIn;
+}
+
 void
 ChosenBp::addChildNode(int indexIn) {
     childrenNodes.push_back(indexIn);
@@ -0,0 +1,188 @@
+/*
+ * CompactAlignment.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "CompactAlignment.h"
+#include "ChrConverter.h"
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+
+namespace sophia {
+
+using namespace std;
+
+CompactAlignment::CompactAlignment()
+    : lowMapq{false}, nullMapq{true}, distantMate{0}, chrIndex{0},
+      readType{0}, startPos{0}, endPos{0}, mateChrIndex{0}, matePos{0},
+      supplementary{false}, fwdStrand{true}, invertedMate{false},
+      eventCandidate{false}, readLength{0}, mateOnDifferentChromosome{false},
+      insertSize{0}, beyondIsizeMax{false} {}
+
+CompactAlignment::CompactAlignment(string_view samLine,
+                                   const vector<int> &fieldTabs)
+    : CompactAlignment{} {
+    chrIndex = ChrConverter::readChromosomeIndex(
+        next(samLine.cbegin(), fieldTabs[1] + 1), '\t');
+    auto mapq = 0;
+    for (auto mapq_cit = samLine.cbegin() + 1 + fieldTabs[3];
+         mapq_cit != samLine.cbegin() + fieldTabs[4]; ++mapq_cit) {
+        mapq = mapq * 10 + (*mapq_cit - '0');
+    }
+    mappingQualityCheck(mapq);
+    for (auto startPos_cit = samLine.cbegin() + 1 + fieldTabs[2];
+         startPos_cit != samLine.cbegin() + fieldTabs[3]; ++startPos_cit) {
+        startPos = startPos * 10 + (*startPos_cit - '0');
+    }
+    readLength = (fieldTabs[9] - fieldTabs[8] - 1);
+    endPos = startPos + readLength;
+    auto flag = 0;
+    for (auto flag_cit = samLine.cbegin() + 1 + fieldTabs[0];
+         flag_cit != samLine.cbegin() + fieldTabs[1]; ++flag_cit) {
+        flag = flag * 10 + (*flag_cit - '0');
+    }
+    decodeFlag(flag);
+    eventCandidate = hasClipsOrIndels(samLine, fieldTabs);
+    mateOnDifferentChromosome = samLine[1 + fieldTabs[5]] != '=';
+    auto isize_cit = samLine.cbegin() + 1 + fieldTabs[7];
+    if (*isize_cit == '-') {
+        ++isize_cit;
+    }
+    for (; isize_cit != samLine.cbegin() + fieldTabs[8]; ++isize_cit) {
+        insertSize = insertSize * 10 + (*isize_cit - '0');
+    }
+    for (auto mpos_cit = samLine.cbegin() + 1 + fieldTabs[6];
+         mpos_cit != samLine.cbegin() + fieldTabs[7]; ++mpos_cit) {
+        matePos = matePos * 10 + (*mpos_cit - '0');
+    }
+    if (!mateOnDifferentChromosome) {
+        mateChrIndex = chrIndex;
+    } else {
+        mateChrIndex = ChrConverter::readChromosomeIndex(
+            next(samLine.cbegin(), 1 + fieldTabs[5]), '\t');
+    }
+}
+
+CompactAlignment::CompactAlignment(const BamRecord &record)
+    : lowMapq{false}, nullMapq{true}, distantMate{0},
+      chrIndex{record.getChrIndex()}, readType{0},
+      startPos{record.getPos() + 1}, endPos{0},
+      mateChrIndex{record.getMateChrIndex()},
+      matePos{record.getMatePos() + 1}, supplementary{false},
+      fwdStrand{true}, invertedMate{false},
+      eventCandidate{record.isEventCandidate()}, readLength{0},
+      mateOnDifferentChromosome{record.getMateRefId() != record.getRefId()},
+      insertSize{abs(record.getTemplateLength())}, beyondIsizeMax{false} {
+    mappingQualityCheck(record.getMapq());
+    // a missing SEQ is the one character wide '*' in SAM, the text input
+    // therefore sees a read length of 1
+    readLength = max(1, record.getSequenceLength());
+    endPos = startPos + readLength;
+    decodeFlag(record.getFlag());
+}
+
+void
+CompactAlignment::classifyPlainRead(double isizeMax) {
+    beyondIsizeMax = insertSize > isizeMax;
+    if (readType == 7) {
+        readType = 5;
+    }
+    markDistantMate();
+}
+
+void
+CompactAlignment::markDistantMate() {
+    switch (readType) {
+    case 0:
+    case 3:
+    case 5:
+        assessOutlierMateDistance();
+        if (distantMate == 1 && readType != 5) {
+            readType = 4;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+bool
+CompactAlignment::assessOutlierMateDistance() {
+    switch (distantMate) {
+    case -1:
+        return false;
+    case 1:
+        return true;
+    default:
+        if (mateOnDifferentChromosome || beyondIsizeMax) {
+            distantMate = 1;
+            return true;
+        }
+        distantMate = -1;
+        return false;
+    }
+}
+
+void
+CompactAlignment::mappingQualityCheck(int mapq) {
+    if (mapq != 0) {   // mapq 0 is treated as a special case, where number of
+                       // SAs and base qualities will be the sole determinants
+                       // of read quality
+        nullMapq = false;
+        if (mapq < 13) {
+            readType = 7;
+            lowMapq = true;
+        }
+    }
+}
+
+void
+CompactAlignment::decodeFlag(int flag) {
+    auto flags = bitset<12>(flag);
+    supplementary = (flags[11] == true);
+    fwdStrand = (flags[4] == false);
+    auto mateFwdStrand = (flags[5] == false);
+    invertedMate = (fwdStrand == mateFwdStrand);
+}
+
+bool
+CompactAlignment::hasClipsOrIndels(string_view samLine,
+                                   const vector<int> &fieldTabs) {
+    if (samLine[fieldTabs[5] - 1] != 'M') {
+        return true;
+    } else {
+        for (auto cigarString_cit = samLine.cbegin() + 1 + fieldTabs[4];
+             cigarString_cit != samLine.cbegin() + fieldTabs[5] - 1;
+             ++cigarString_cit) {
+            switch (*cigarString_cit) {
+            case 'S':
+            case 'H':
+            case 'I':
+            case 'D':
+                return true;
+            default:
+                break;
+            }
+        }
+        return false;
+    }
+}
+
+} /* namespace sophia */
@@ -0,0 +1,154 @@
+/*
+ * CoverageWindow.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "CoverageWindow.h"
+#include <algorithm>
+
+namespace sophia {
+
+using namespace std;
+
+namespace {
+
+int
+capacityFor(int length) {
+    auto capacity = 1024;
+    while (capacity < length) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // namespace
+
+CoverageWindow::CoverageWindow(int expectedLength)
+    : mask{capacityFor(expectedLength) - 1}, minPos{-1}, maxPos{-1},
+      summedTo{-1}, spanSums{}, coverage{}, normalBpsSoft{}, normalBpsHard{},
+      normalBpsShortIndel{}, normalSpans{}, lowQualSpansSoft{},
+      lowQualSpansHard{}, lowQualBpsSoft{}, lowQualBpsHard{} {
+    for (auto counter : counters()) {
+        counter->resize(mask + 1);
+    }
+}
+
+template <typename Update>
+void
+CoverageWindow::forIndexRanges(int startPos, int endPos, Update update) const {
+    if (startPos >= endPos) {
+        return;
+    }
+    auto from = startPos & mask;
+    auto to = from + (endPos - startPos);
+    if (to <= mask + 1) {
+        update(from, to);
+    } else {
+        update(from, mask + 1);
+        update(0, to - (mask + 1));
+    }
+}
+
+void
+CoverageWindow::start(int startPos, int lastPos) {
+    minPos = startPos;
+    maxPos = startPos - 1;
+    summedTo = startPos;
+    spanSums.fill(0);
+    // the slot past maxPos was not zeroed by an earlier append
+    for (auto counter : counters()) {
+        (*counter)[startPos & mask] = 0;
+    }
+    extendTo(lastPos);
+}
+
+void
+CoverageWindow::dropBefore(int pos) {
+    if (minPos < pos) {
+        if (maxPos < pos) {
+            clear();
+        } else {
+            sumUpTo(pos - 1);
+            minPos = pos;
+        }
+    }
+}
+
+void
+CoverageWindow::sumUpTo(int pos) {
+    pos = min(pos, maxPos);
+    if (pos < summedTo) {
+        return;
+    }
+    auto counterIndex = 0;
+    for (auto counter : spanCounters()) {
+        auto &sum = spanSums[counterIndex++];
+        forIndexRanges(summedTo, pos + 1, [counter, &sum](int from, int to) {
+            auto data = counter->data();
+            for (auto i = from; i < to; ++i) {
+                sum += data[i];
+                data[i] = sum;
+            }
+        });
+    }
+    summedTo = pos + 1;
+}
+
+void
+CoverageWindow::append(int pos) {
+    if (pos - minPos + 2 > mask + 1) {
+        grow(pos - minPos + 2);
+    }
+    // the slots of the new positions still hold dropped ones, apart from the
+    // one past maxPos with the ends of the spans
+    forIndexRanges(maxPos + 2, pos + 2, [this](int from, int to) {
+        for (auto counter : counters()) {
+            fill(counter->begin() + from, counter->begin() + to, 0);
+        }
+    });
+    maxPos = pos;
+}
+
+void
+CoverageWindow::grow(int length) {
+    auto grownMask = capacityFor(length) - 1;
+    for (auto counter : counters()) {
+        vector<int> grown(grownMask + 1);
+        for (auto pos = minPos; pos <= maxPos + 1; ++pos) {
+            grown[pos & grownMask] = (*counter)[pos & mask];
+        }
+        counter->swap(grown);
+    }
+    mask = grownMask;
+}
+
+array<vector<int> *, CoverageWindow::COUNTERS>
+CoverageWindow::counters() {
+    return {&coverage, &normalBpsSoft, &normalBpsHard, &normalBpsShortIndel,
+            &normalSpans, &lowQualSpansSoft, &lowQualSpansHard,
+            &lowQualBpsSoft, &lowQualBpsHard};
+}
+
+array<vector<int> *, CoverageWindow::SPANCOUNTERS>
+CoverageWindow::spanCounters() {
+    return {&coverage, &normalSpans, &lowQualSpansSoft, &lowQualSpansHard};
+}
+
+} /* namespace sophia */
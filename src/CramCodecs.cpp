@@ -0,0 +1,494 @@
+/*
+ * CramCodecs.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "CramCodecs.h"
+#include "HelperFunctions.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <zlib.h>
+
+namespace sophia {
+
+using namespace std;
+
+void
+cramFormatError(const string &reason) {
+    cerr << "Error reading CRAM input: " << reason << endl;
+    exit(EXITCODE_IOERROR);
+}
+
+const unsigned char *
+CramByteReader::readUntil(unsigned char stopByte, size_t &length) {
+    auto stop = static_cast<const unsigned char *>(
+        memchr(cursor, stopByte, end - cursor));
+    if (stop == nullptr) {
+        cramFormatError("unterminated byte array");
+    }
+    auto start = cursor;
+    length = stop - cursor;
+    cursor = stop + 1;
+    return start;
+}
+
+int32_t
+CramByteReader::readInt32() {
+    auto bytes = readBytes(4);
+    return static_cast<int32_t>(
+        static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+        static_cast<uint32_t>(bytes[2]) << 16 |
+        static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+int32_t
+CramByteReader::readItf8() {
+    // the count of leading 1 bits of the first byte gives the count of
+    // following bytes, the 5 byte form carries only 4 bits in its last byte
+    uint32_t first = readByte();
+    if ((first & 0x80) == 0) {
+        return static_cast<int32_t>(first);
+    }
+    if ((first & 0x40) == 0) {
+        return static_cast<int32_t>((first & 0x3f) << 8 | readByte());
+    }
+    if ((first & 0x20) == 0) {
+        auto value = (first & 0x1f) << 16;
+        value |= static_cast<uint32_t>(readByte()) << 8;
+        return static_cast<int32_t>(value | readByte());
+    }
+    if ((first & 0x10) == 0) {
+        auto value = (first & 0x0f) << 24;
+        value |= static_cast<uint32_t>(readByte()) << 16;
+        value |= static_cast<uint32_t>(readByte()) << 8;
+        return static_cast<int32_t>(value | readByte());
+    }
+    auto value = (first & 0x0f) << 28;
+    value |= static_cast<uint32_t>(readByte()) << 20;
+    value |= static_cast<uint32_t>(readByte()) << 12;
+    value |= static_cast<uint32_t>(readByte()) << 4;
+    return static_cast<int32_t>(value | (readByte() & 0x0f));
+}
+
+int64_t
+CramByteReader::readLtf8() {
+    uint64_t first = readByte();
+    auto extraBytes = 0;
+    while (extraBytes < 8 && (first & (0x80 >> extraBytes)) != 0) {
+        ++extraBytes;
+    }
+    auto value = extraBytes < 7 ? first & (0x7f >> extraBytes) : uint64_t{0};
+    for (auto i = 0; i < extraBytes; ++i) {
+        value = (value << 8) | readByte();
+    }
+    return static_cast<int64_t>(value);
+}
+
+namespace {
+
+// rANS with 32 bit states, 4 interleaved streams and 12 bit frequencies, as
+// used by method 4 blocks of CRAM 3.0
+const uint32_t RANSLOWERBOUND = 1u << 23;
+const int RANSFREQUENCYBITS = 12;
+const uint32_t RANSFREQUENCYMASK = (1u << RANSFREQUENCYBITS) - 1;
+
+struct RansSymbol {
+    uint32_t start;
+    uint32_t frequency;
+};
+
+class RansFrequencyTable {
+  public:
+    RansFrequencyTable() : symbols{}, lookup{} {}
+    // reads the run length encoded frequency table of one context
+    void read(CramByteReader &reader) {
+        auto total = 0u;
+        auto runLength = 0;
+        auto symbol = static_cast<int>(reader.readByte());
+        auto previous = -1;
+        do {
+            uint32_t frequency = reader.readByte();
+            if (frequency >= 128) {
+                frequency = ((frequency & 0x7f) << 8) | reader.readByte();
+            }
+            if (total + frequency > (1u << RANSFREQUENCYBITS)) {
+                cramFormatError("invalid rANS frequency table");
+            }
+            symbols[symbol] = RansSymbol{total, frequency};
+            fill(lookup.begin() + total, lookup.begin() + total + frequency,
+                 static_cast<unsigned char>(symbol));
+            total += frequency;
+            previous = symbol;
+            if (runLength > 0) {
+                --runLength;
+                symbol = previous + 1;
+            } else {
+                symbol = reader.readByte();
+                if (symbol == previous + 1) {
+                    runLength = reader.readByte();
+                }
+            }
+        } while (symbol != 0 && symbol < 256);
+    }
+    unsigned char decodeSymbol(uint32_t &state, CramByteReader &reader) const {
+        auto slot = state & RANSFREQUENCYMASK;
+        auto symbol = lookup[slot];
+        const auto &entry = symbols[symbol];
+        state = entry.frequency * (state >> RANSFREQUENCYBITS) + slot -
+                entry.start;
+        while (state < RANSLOWERBOUND) {
+            state = (state << 8) | reader.readByte();
+        }
+        return symbol;
+    }
+
+  private:
+    array<RansSymbol, 256> symbols;
+    array<unsigned char, 1u << RANSFREQUENCYBITS> lookup;
+};
+
+uint32_t
+readRansState(CramByteReader &reader) {
+    return static_cast<uint32_t>(reader.readInt32());
+}
+
+void
+ransDecompress(const unsigned char *compressed, size_t compressedSize,
+               vector<unsigned char> &out) {
+    CramByteReader reader{compressed, compressed + compressedSize};
+    auto order = reader.readByte();
+    reader.readInt32();
+    auto rawSize = static_cast<uint32_t>(reader.readInt32());
+    if (rawSize != out.size()) {
+        cramFormatError("rANS size mismatch");
+    }
+    if (order == 0) {
+        auto table = make_unique<RansFrequencyTable>();
+        table->read(reader);
+        array<uint32_t, 4> states{};
+        for (auto &state : states) {
+            state = readRansState(reader);
+        }
+        for (auto i = 0u; i < rawSize; ++i) {
+            out[i] = table->decodeSymbol(states[i % 4], reader);
+        }
+        return;
+    }
+    // order 1: one frequency table per preceding symbol, each of the four
+    // states decodes one contiguous quarter of the output
+    vector<RansFrequencyTable> tables(256);
+    auto runLength = 0;
+    auto context = static_cast<int>(reader.readByte());
+    auto previous = -1;
+    do {
+        tables[context].read(reader);
+        previous = context;
+        if (runLength > 0) {
+            --runLength;
+            context = previous + 1;
+        } else {
+            context = reader.readByte();
+            if (context == previous + 1) {
+                runLength = reader.readByte();
+            }
+        }
+    } while (context != 0 && context < 256);
+    array<uint32_t, 4> states{};
+    for (auto &state : states) {
+        state = readRansState(reader);
+    }
+    auto quarter = rawSize / 4;
+    array<unsigned char, 4> contexts{};
+    for (auto i = 0u; i < quarter; ++i) {
+        for (auto j = 0u; j < 4; ++j) {
+            contexts[j] =
+                tables[contexts[j]].decodeSymbol(states[j], reader);
+            out[j * quarter + i] = contexts[j];
+        }
+    }
+    for (auto i = 4 * quarter; i < rawSize; ++i) {
+        contexts[3] = tables[contexts[3]].decodeSymbol(states[3], reader);
+        out[i] = contexts[3];
+    }
+}
+
+void
+gzipDecompress(const unsigned char *compressed, size_t compressedSize,
+               vector<unsigned char> &out) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        cramFormatError("zlib initialization failed");
+    }
+    stream.next_in = const_cast<unsigned char *>(compressed);
+    stream.avail_in = static_cast<uInt>(compressedSize);
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    auto status = Z_OK;
+    while (status == Z_OK) {
+        status = inflate(&stream, Z_FINISH);
+        // concatenated gzip members
+        if (status == Z_STREAM_END && stream.avail_in > 0 &&
+            stream.avail_out > 0) {
+            status = inflateReset(&stream);
+        }
+    }
+    inflateEnd(&stream);
+    if (status != Z_STREAM_END || stream.avail_out != 0) {
+        cramFormatError("corrupt gzip block");
+    }
+}
+
+} // namespace
+
+CramBlock::CramBlock(CramByteReader &reader)
+    : method{reader.readByte()}, contentType{reader.readByte()},
+      contentId{reader.readItf8()}, data{} {
+    auto compressedSize = reader.readItf8();
+    auto rawSize = reader.readItf8();
+    if (compressedSize < 0 || rawSize < 0) {
+        cramFormatError("invalid block size");
+    }
+    auto compressed = reader.readBytes(compressedSize);
+    reader.readInt32();   // CRC32
+    decompress(compressed, compressedSize, rawSize);
+}
+
+void
+CramBlock::decompress(const unsigned char *compressed, size_t compressedSize,
+                      size_t rawSize) {
+    data.resize(rawSize);
+    switch (method) {
+    case 0:
+        if (compressedSize != rawSize) {
+            cramFormatError("raw block size mismatch");
+        }
+        copy(compressed, compressed + compressedSize, data.begin());
+        break;
+    case 1:
+        if (rawSize > 0) {
+            gzipDecompress(compressed, compressedSize, data);
+        }
+        break;
+    case 4:
+        ransDecompress(compressed, compressedSize, data);
+        break;
+    default:
+        cramFormatError("unsupported block compression method " +
+                        to_string(method) +
+                        ", only raw, gzip and rANS (CRAM 3.0) are supported");
+    }
+}
+
+CramEncoding::CramEncoding()
+    : codec{NULLCODEC}, externalId{-1}, offset{0}, bitCount{0}, stopByte{0},
+      huffmanSymbols{}, huffmanFirstCode{}, huffmanFirstIndex{},
+      huffmanCodeCount{}, lengthEncoding{}, valueEncoding{} {}
+
+CramEncoding::CramEncoding(CramByteReader &reader) : CramEncoding{} {
+    codec = reader.readItf8();
+    auto parameterLength = reader.readItf8();
+    auto parameters = reader.readBytes(parameterLength);
+    CramByteReader parameterReader{parameters, parameters + parameterLength};
+    switch (codec) {
+    case NULLCODEC:
+        break;
+    case EXTERNAL:
+        externalId = parameterReader.readItf8();
+        break;
+    case HUFFMAN: {
+        vector<int> symbols(parameterReader.readItf8());
+        for (auto &symbol : symbols) {
+            symbol = parameterReader.readItf8();
+        }
+        vector<int> lengths(parameterReader.readItf8());
+        for (auto &length : lengths) {
+            length = parameterReader.readItf8();
+        }
+        if (symbols.empty() || symbols.size() != lengths.size()) {
+            cramFormatError("invalid huffman code");
+        }
+        vector<int> order(symbols.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int lhs, int rhs) {
+            return lengths[lhs] != lengths[rhs] ? lengths[lhs] < lengths[rhs]
+                                                : symbols[lhs] < symbols[rhs];
+        });
+        auto maxLength = lengths[order.back()];
+        if (maxLength > 31) {
+            cramFormatError("huffman code too long");
+        }
+        huffmanFirstCode.assign(maxLength + 1, 0);
+        huffmanFirstIndex.assign(maxLength + 1, 0);
+        huffmanCodeCount.assign(maxLength + 1, 0);
+        auto code = 0;
+        auto previousLength = lengths[order.front()];
+        for (auto i = 0u; i < order.size(); ++i) {
+            auto length = lengths[order[i]];
+            code <<= (length - previousLength);
+            previousLength = length;
+            if (huffmanCodeCount[length] == 0) {
+                huffmanFirstCode[length] = code;
+                huffmanFirstIndex[length] = static_cast<int>(i);
+            }
+            ++huffmanCodeCount[length];
+            huffmanSymbols.push_back(symbols[order[i]]);
+            ++code;
+        }
+        break;
+    }
+    case BYTEARRAYLEN:
+        lengthEncoding = make_shared<CramEncoding>(parameterReader);
+        valueEncoding = make_shared<CramEncoding>(parameterReader);
+        break;
+    case BYTEARRAYSTOP:
+        stopByte = parameterReader.readByte();
+        externalId = parameterReader.readItf8();
+        break;
+    case BETA:
+    case SUBEXP:
+        offset = parameterReader.readItf8();
+        bitCount = parameterReader.readItf8();
+        break;
+    case GAMMA:
+        offset = parameterReader.readItf8();
+        break;
+    default:
+        cramFormatError("unsupported encoding " + to_string(codec));
+    }
+}
+
+int
+CramEncoding::decodeInt(CramDataStreams &streams) const {
+    if (codec == EXTERNAL) {
+        return streams.external(externalId).readItf8();
+    }
+    return decodeBits(streams);
+}
+
+unsigned char
+CramEncoding::decodeByte(CramDataStreams &streams) const {
+    if (codec == EXTERNAL) {
+        return streams.external(externalId).readByte();
+    }
+    return static_cast<unsigned char>(decodeBits(streams));
+}
+
+void
+CramEncoding::decodeByteRun(CramDataStreams &streams, int count,
+                            unsigned char *out) const {
+    if (codec == EXTERNAL) {
+        auto bytes = streams.external(externalId).readBytes(count);
+        if (out != nullptr) {
+            copy(bytes, bytes + count, out);
+        }
+        return;
+    }
+    for (auto i = 0; i < count; ++i) {
+        auto value = decodeByte(streams);
+        if (out != nullptr) {
+            out[i] = value;
+        }
+    }
+}
+
+void
+CramEncoding::decodeByteArray(CramDataStreams &streams,
+                              vector<unsigned char> &out) const {
+    switch (codec) {
+    case BYTEARRAYLEN: {
+        auto length = lengthEncoding->decodeInt(streams);
+        if (length < 0) {
+            cramFormatError("negative byte array length");
+        }
+        auto oldSize = out.size();
+        out.resize(oldSize + length);
+        valueEncoding->decodeByteRun(streams, length, out.data() + oldSize);
+        break;
+    }
+    case BYTEARRAYSTOP: {
+        size_t length{0};
+        auto bytes =
+            streams.external(externalId).readUntil(stopByte, length);
+        out.insert(out.end(), bytes, bytes + length);
+        break;
+    }
+    case NULLCODEC:
+        break;
+    default:
+        cramFormatError("encoding " + to_string(codec) +
+                        " cannot decode byte arrays");
+    }
+}
+
+int
+CramEncoding::decodeBits(CramDataStreams &streams) const {
+    switch (codec) {
+    case NULLCODEC:
+        return 0;
+    case HUFFMAN:
+        return decodeHuffman(streams.core);
+    case BETA:
+        return streams.core.readBits(bitCount) - offset;
+    case SUBEXP: {
+        auto unary = 0;
+        while (streams.core.readBit() == 1) {
+            ++unary;
+        }
+        if (unary == 0) {
+            return streams.core.readBits(bitCount) - offset;
+        }
+        auto tailBits = unary + bitCount - 1;
+        return ((1 << tailBits) | streams.core.readBits(tailBits)) - offset;
+    }
+    case GAMMA: {
+        auto leadingZeros = 0;
+        while (streams.core.readBit() == 0) {
+            ++leadingZeros;
+        }
+        return ((1 << leadingZeros) | streams.core.readBits(leadingZeros)) -
+               offset;
+    }
+    default:
+        cramFormatError("encoding " + to_string(codec) +
+                        " cannot decode values");
+    }
+}
+
+int
+CramEncoding::decodeHuffman(CramBitReader &core) const {
+    // a single symbol is stored with zero bits
+    if (huffmanSymbols.size() == 1) {
+        return huffmanSymbols.front();
+    }
+    auto code = 0;
+    for (auto length = 1u; length < huffmanCodeCount.size(); ++length) {
+        code = (code << 1) | core.readBit();
+        auto index = code - huffmanFirstCode[length];
+        if (huffmanCodeCount[length] > 0 && index >= 0 &&
+            index < huffmanCodeCount[length]) {
+            return huffmanSymbols[huffmanFirstIndex[length] + index];
+        }
+    }
+    cramFormatError("invalid huffman code in core block");
+}
+
+} /* namespace sophia */
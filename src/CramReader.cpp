@@ -0,0 +1,1056 @@
+/*
+ * CramReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "CramReader.h"
+#include "HelperFunctions.h"
+#include "Md5.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace sophia {
+
+using namespace std;
+
+namespace {
+
+// CRAM record flags
+const int CRAMQUALITYARRAY = 0x1;
+const int CRAMDETACHED = 0x2;
+const int CRAMMATEDOWNSTREAM = 0x4;
+const int CRAMNOSEQUENCE = 0x8;
+
+// BAM CIGAR operation codes
+const uint32_t CIGARM = 0, CIGARI = 1, CIGARD = 2, CIGARN = 3, CIGARS = 4,
+               CIGARH = 5, CIGARP = 6;
+
+array<unsigned char, 256>
+makeBaseCodes() {
+    array<unsigned char, 256> codes{};
+    codes.fill(15);
+    const string bases{"=ACMGRSVTWYHKDBN"};
+    for (auto i = 0u; i < bases.size(); ++i) {
+        codes[static_cast<unsigned char>(bases[i])] =
+            static_cast<unsigned char>(i);
+        codes[static_cast<unsigned char>(tolower(bases[i]))] =
+            static_cast<unsigned char>(i);
+    }
+    return codes;
+}
+
+const array<unsigned char, 256> BASECODES = makeBaseCodes();
+
+int
+substitutionRow(char referenceBase) {
+    switch (referenceBase) {
+    case 'A':
+        return 0;
+    case 'C':
+        return 1;
+    case 'G':
+        return 2;
+    case 'T':
+        return 3;
+    default:
+        return 4;
+    }
+}
+
+void
+writeInt32(char *dest, int32_t value) {
+    memcpy(dest, &value, sizeof(value));
+}
+
+void
+writeUint16(char *dest, int value) {
+    auto narrowed = static_cast<uint16_t>(value);
+    memcpy(dest, &narrowed, sizeof(narrowed));
+}
+
+void
+addCigarOperation(vector<uint32_t> &cigar, uint32_t operation, int length) {
+    if (length <= 0) {
+        return;
+    }
+    if (!cigar.empty() && (cigar.back() & 0xf) == operation) {
+        cigar.back() += static_cast<uint32_t>(length) << 4;
+    } else {
+        cigar.push_back(static_cast<uint32_t>(length) << 4 | operation);
+    }
+}
+
+} // namespace
+
+CramReader::CramReader(const string &fileNameIn,
+                       const string &referenceFileName, int threadsIn)
+    : fileName{fileNameIn}, THREADS{max(1, threadsIn)},
+      fileHandle{fopen(fileNameIn.c_str(), "rb")}, referenceFasta{},
+      slicePool{}, currentSlice{nullptr}, currentOffset{0}, freeSlices{},
+      pendingSlices{}, decodeQueue{}, endOfFile{false}, shuttingDown{false},
+      threadPool{} {
+    if (fileHandle == nullptr) {
+        perror(("Error opening " + fileName).c_str());
+        exit(EXITCODE_IOERROR);
+    }
+    if (!referenceFileName.empty()) {
+        referenceFasta = make_unique<ReferenceFasta>(referenceFileName);
+    }
+    readFileDefinition();
+    readSamHeader();
+    if (THREADS > 1) {
+        // one slice is held by the consumer, the rest may be queued or
+        // decoding
+        for (auto i = 0; i < 4 * THREADS + 1; ++i) {
+            slicePool.push_back(make_unique<Slice>());
+            freeSlices.push_back(slicePool.back().get());
+        }
+        threadPool.emplace_back(&CramReader::ioLoop, this);
+        for (auto i = 0; i < THREADS; ++i) {
+            threadPool.emplace_back(&CramReader::workerLoop, this);
+        }
+    }
+}
+
+CramReader::~CramReader() {
+    {
+        lock_guard<mutex> lock{queueMutex};
+        shuttingDown = true;
+    }
+    slotAvailable.notify_all();
+    workAvailable.notify_all();
+    sliceReady.notify_all();
+    for (auto &worker : threadPool) {
+        worker.join();
+    }
+    fclose(fileHandle);
+}
+
+bool
+CramReader::nextRecord(BamRecord &record) {
+    while (currentSlice == nullptr ||
+           currentOffset == currentSlice->records.size()) {
+        if (!nextSlice()) {
+            return false;
+        }
+    }
+    int32_t blockSize{0};
+    memcpy(&blockSize, currentSlice->records.data() + currentOffset,
+           sizeof(blockSize));
+    record.assign(currentSlice->records.data() + currentOffset + 4, blockSize);
+    currentOffset += 4 + blockSize;
+    record.setChrIndices(toChrIndex(record.getRefId()),
+                         toChrIndex(record.getMateRefId()));
+    return true;
+}
+
+void
+CramReader::readFileDefinition() {
+    // "CRAM", major and minor version, 20 bytes of file id
+    unsigned char definition[26];
+    if (fread(definition, 1, sizeof(definition), fileHandle) !=
+            sizeof(definition) ||
+        memcmp(definition, "CRAM", 4) != 0) {
+        cerr << fileName << " is not a CRAM file" << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    if (definition[4] != 3) {
+        cerr << fileName << " is CRAM version "
+             << static_cast<int>(definition[4]) << "."
+             << static_cast<int>(definition[5])
+             << ", only CRAM 3 is supported" << endl;
+        exit(EXITCODE_IOERROR);
+    }
+}
+
+void
+CramReader::readSamHeader() {
+    int refId{0}, recordCount{0}, dataLength{0};
+    vector<int> landmarks;
+    if (!readContainerHeader(refId, recordCount, dataLength, landmarks)) {
+        cramFormatError("missing SAM header container");
+    }
+    vector<unsigned char> data(dataLength);
+    if (fread(data.data(), 1, dataLength, fileHandle) !=
+        static_cast<size_t>(dataLength)) {
+        cramFormatError("truncated SAM header container");
+    }
+    CramByteReader containerReader{data.data(), data.data() + data.size()};
+    CramBlock block{containerReader};
+    const auto &blockData = block.getData();
+    CramByteReader textReader{blockData.data(),
+                              blockData.data() + blockData.size()};
+    auto textLength = textReader.readInt32();
+    auto text =
+        reinterpret_cast<const char *>(textReader.readBytes(textLength));
+    // the @SQ lines give the reference names in the order of the ids
+    string line;
+    for (auto i = 0; i <= textLength; ++i) {
+        if (i < textLength && text[i] != '\n') {
+            line.push_back(text[i]);
+            continue;
+        }
+        if (line.compare(0, 3, "@SQ") == 0) {
+            auto nameStart = line.find("\tSN:");
+            if (nameStart != string::npos) {
+                nameStart += 4;
+                addReference(line.substr(
+                    nameStart, line.find('\t', nameStart) - nameStart));
+            }
+        }
+        line.clear();
+    }
+}
+
+bool
+CramReader::readContainerHeader(int &refId, int &recordCount, int &dataLength,
+                                vector<int> &landmarks) {
+    unsigned char lengthBytes[4];
+    auto lengthRead = fread(lengthBytes, 1, sizeof(lengthBytes), fileHandle);
+    if (lengthRead == 0 && feof(fileHandle)) {
+        return false;
+    }
+    if (lengthRead != sizeof(lengthBytes)) {
+        cramFormatError("truncated container header");
+    }
+    CramByteReader lengthReader{lengthBytes, lengthBytes + 4};
+    dataLength = lengthReader.readInt32();
+    refId = readFileItf8();
+    readFileItf8();   // alignment start
+    readFileItf8();   // alignment span
+    recordCount = readFileItf8();
+    readFileLtf8();   // record counter
+    readFileLtf8();   // bases
+    readFileItf8();   // block count
+    landmarks.resize(readFileItf8());
+    for (auto &landmark : landmarks) {
+        landmark = readFileItf8();
+    }
+    for (auto i = 0; i < 4; ++i) {
+        readFileByte();   // CRC32
+    }
+    if (dataLength < 0) {
+        cramFormatError("invalid container length");
+    }
+    return true;
+}
+
+bool
+CramReader::readContainer() {
+    while (true) {
+        int refId{0}, recordCount{0}, dataLength{0};
+        vector<int> landmarks;
+        if (!readContainerHeader(refId, recordCount, dataLength, landmarks)) {
+            return false;
+        }
+        vector<unsigned char> data(dataLength);
+        if (fread(data.data(), 1, dataLength, fileHandle) !=
+            static_cast<size_t>(dataLength)) {
+            cramFormatError("truncated container");
+        }
+        // the EOF marker is an empty container, refId -1 holds only
+        // unplaced unmapped reads which are never used
+        if (recordCount == 0 || refId == -1) {
+            continue;
+        }
+        CramByteReader reader{data.data(), data.data() + data.size()};
+        auto compressionHeader = parseCompressionHeader(CramBlock{reader});
+        for (auto i = 0u; i < landmarks.size(); ++i) {
+            auto sliceStart = landmarks[i];
+            auto sliceEnd =
+                i + 1 < landmarks.size() ? landmarks[i + 1] : dataLength;
+            if (sliceStart < 0 || sliceStart > sliceEnd ||
+                sliceEnd > dataLength) {
+                cramFormatError("invalid slice offsets");
+            }
+            auto slice = acquireSlice();
+            if (slice == nullptr) {
+                return false;
+            }
+            slice->compressionHeader = compressionHeader;
+            slice->compressed.assign(data.begin() + sliceStart,
+                                     data.begin() + sliceEnd);
+            slice->ready = false;
+            {
+                lock_guard<mutex> lock{queueMutex};
+                pendingSlices.push_back(slice);
+                if (THREADS > 1) {
+                    decodeQueue.push_back(slice);
+                }
+            }
+            workAvailable.notify_one();
+        }
+        return true;
+    }
+}
+
+shared_ptr<const CramReader::CompressionHeader>
+CramReader::parseCompressionHeader(const CramBlock &block) const {
+    if (block.getContentType() != 1) {
+        cramFormatError("missing compression header");
+    }
+    auto header = make_shared<CompressionHeader>();
+    header->readNamesIncluded = true;
+    header->positionDeltas = true;
+    header->referenceRequired = true;
+    // default substitution matrix, in the order of the remaining bases
+    header->substitutions = {{{{'C', 'G', 'T', 'N'}},
+                              {{'A', 'G', 'T', 'N'}},
+                              {{'A', 'C', 'T', 'N'}},
+                              {{'A', 'C', 'G', 'N'}},
+                              {{'A', 'C', 'G', 'T'}}}};
+    const auto &data = block.getData();
+    CramByteReader reader{data.data(), data.data() + data.size()};
+
+    reader.readItf8();   // preservation map size
+    auto entryCount = reader.readItf8();
+    for (auto i = 0; i < entryCount; ++i) {
+        auto key = string{static_cast<char>(reader.readByte())};
+        key.push_back(static_cast<char>(reader.readByte()));
+        if (key == "RN") {
+            header->readNamesIncluded = reader.readByte() != 0;
+        } else if (key == "AP") {
+            header->positionDeltas = reader.readByte() != 0;
+        } else if (key == "RR") {
+            header->referenceRequired = reader.readByte() != 0;
+        } else if (key == "SM") {
+            // for each reference base, 2 bit substitution codes of the
+            // remaining bases in ACGTN order
+            const string remaining[5] = {"CGTN", "AGTN", "ACTN", "ACGN",
+                                         "ACGT"};
+            for (auto row = 0; row < 5; ++row) {
+                auto codes = reader.readByte();
+                for (auto j = 0; j < 4; ++j) {
+                    header->substitutions[row][(codes >> (6 - 2 * j)) & 3] =
+                        remaining[row][j];
+                }
+            }
+        } else if (key == "TD") {
+            auto dictionaryLength = reader.readItf8();
+            auto dictionary = reader.readBytes(dictionaryLength);
+            vector<int> tagLine;
+            for (auto j = 0; j < dictionaryLength;) {
+                if (dictionary[j] == 0) {
+                    header->tagLines.push_back(tagLine);
+                    tagLine.clear();
+                    ++j;
+                } else if (j + 3 <= dictionaryLength) {
+                    tagLine.push_back(dictionary[j] << 16 |
+                                      dictionary[j + 1] << 8 |
+                                      dictionary[j + 2]);
+                    j += 3;
+                } else {
+                    cramFormatError("invalid tag dictionary");
+                }
+            }
+        } else {
+            cramFormatError("unknown preservation map key " + key);
+        }
+    }
+
+    const string dataSeriesKeys[DATASERIESCOUNT] = {
+        "BF", "CF", "RI", "RL", "AP", "RG", "RN", "MF", "NS", "NP",
+        "TS", "NF", "TL", "FN", "FC", "FP", "DL", "BB", "QQ", "BS",
+        "IN", "RS", "PD", "HC", "SC", "MQ", "BA", "QS"};
+    reader.readItf8();   // data series map size
+    entryCount = reader.readItf8();
+    for (auto i = 0; i < entryCount; ++i) {
+        auto key = string{static_cast<char>(reader.readByte())};
+        key.push_back(static_cast<char>(reader.readByte()));
+        CramEncoding encoding{reader};
+        auto series = find(begin(dataSeriesKeys), end(dataSeriesKeys), key);
+        // legacy series such as TC and TN are parsed and ignored
+        if (series != end(dataSeriesKeys)) {
+            header->dataSeries[series - begin(dataSeriesKeys)] = encoding;
+        }
+    }
+
+    reader.readItf8();   // tag encoding map size
+    entryCount = reader.readItf8();
+    for (auto i = 0; i < entryCount; ++i) {
+        auto key = reader.readItf8();
+        header->tagEncodings.emplace(key, CramEncoding{reader});
+    }
+    return header;
+}
+
+CramReader::Slice *
+CramReader::acquireSlice() {
+    unique_lock<mutex> lock{queueMutex};
+    if (THREADS == 1) {
+        if (freeSlices.empty()) {
+            slicePool.push_back(make_unique<Slice>());
+            return slicePool.back().get();
+        }
+    } else {
+        slotAvailable.wait(
+            lock, [this] { return !freeSlices.empty() || shuttingDown; });
+        if (shuttingDown) {
+            return nullptr;
+        }
+    }
+    auto slice = freeSlices.back();
+    freeSlices.pop_back();
+    return slice;
+}
+
+bool
+CramReader::nextSlice() {
+    if (THREADS == 1) {
+        if (currentSlice != nullptr) {
+            freeSlices.push_back(currentSlice);
+            currentSlice = nullptr;
+        }
+        while (pendingSlices.empty()) {
+            if (!readContainer()) {
+                return false;
+            }
+        }
+        currentSlice = pendingSlices.front();
+        pendingSlices.pop_front();
+        decodeSlice(*currentSlice);
+        currentOffset = 0;
+        return true;
+    }
+    unique_lock<mutex> lock{queueMutex};
+    if (currentSlice != nullptr) {
+        freeSlices.push_back(currentSlice);
+        currentSlice = nullptr;
+        slotAvailable.notify_one();
+    }
+    sliceReady.wait(lock, [this] {
+        return (!pendingSlices.empty() && pendingSlices.front()->ready) ||
+               (pendingSlices.empty() && endOfFile);
+    });
+    if (pendingSlices.empty()) {
+        return false;
+    }
+    currentSlice = pendingSlices.front();
+    pendingSlices.pop_front();
+    currentOffset = 0;
+    return true;
+}
+
+void
+CramReader::ioLoop() {
+    while (readContainer()) {
+    }
+    {
+        lock_guard<mutex> lock{queueMutex};
+        endOfFile = true;
+    }
+    sliceReady.notify_all();
+}
+
+void
+CramReader::workerLoop() {
+    while (true) {
+        Slice *slice{nullptr};
+        {
+            unique_lock<mutex> lock{queueMutex};
+            workAvailable.wait(lock, [this] {
+                return !decodeQueue.empty() || shuttingDown;
+            });
+            if (shuttingDown) {
+                return;
+            }
+            slice = decodeQueue.front();
+            decodeQueue.pop_front();
+        }
+        decodeSlice(*slice);
+        {
+            lock_guard<mutex> lock{queueMutex};
+            slice->ready = true;
+        }
+        sliceReady.notify_all();
+    }
+}
+
+void
+CramReader::decodeSlice(Slice &slice) {
+    auto &out = slice.records;
+    out.clear();
+    CramByteReader reader{slice.compressed.data(),
+                          slice.compressed.data() + slice.compressed.size()};
+    CramBlock headerBlock{reader};
+    if (headerBlock.getContentType() != 2) {
+        cramFormatError("missing slice header");
+    }
+    const auto &headerData = headerBlock.getData();
+    CramByteReader headerReader{headerData.data(),
+                                headerData.data() + headerData.size()};
+    SliceState state{};
+    state.header = slice.compressionHeader.get();
+    state.refId = headerReader.readItf8();
+    state.lastPosition = headerReader.readItf8();
+    state.embeddedReferenceStart = state.lastPosition;
+    auto alignmentStart = state.lastPosition;
+    auto alignmentSpan = headerReader.readItf8();
+    auto recordCount = headerReader.readItf8();
+    headerReader.readLtf8();   // record counter
+    auto blockCount = headerReader.readItf8();
+    auto contentIdCount = headerReader.readItf8();
+    for (auto i = 0; i < contentIdCount; ++i) {
+        headerReader.readItf8();
+    }
+    auto embeddedReferenceId = headerReader.readItf8();
+    auto referenceMd5 = headerReader.readBytes(16);
+    state.fastaRefId = -1;
+
+    vector<CramBlock> blocks;
+    blocks.reserve(blockCount);
+    for (auto i = 0; i < blockCount; ++i) {
+        blocks.emplace_back(reader);
+    }
+    for (const auto &block : blocks) {
+        const auto &data = block.getData();
+        if (block.getContentType() == 5) {
+            state.streams.core.assign(data.data(), data.data() + data.size());
+        } else if (block.getContentType() == 4) {
+            state.streams.externalBlocks[block.getContentId()] =
+                CramByteReader{data.data(), data.data() + data.size()};
+            if (block.getContentId() == embeddedReferenceId) {
+                state.embeddedReference = &block;
+            }
+        }
+    }
+    checkReferenceMd5(state, alignmentStart, alignmentSpan, referenceMd5);
+
+    state.links.reserve(recordCount);
+    for (auto i = 0; i < recordCount; ++i) {
+        decodeRecord(state, i, out);
+    }
+    resolveMates(state.links);
+    for (const auto &link : state.links) {
+        auto core = out.data() + link.recordOffset + 4;
+        writeUint16(core + 14, link.flag);
+        writeInt32(core + 20, link.mateRefId);
+        writeInt32(core + 24, link.matePos - 1);
+        writeInt32(core + 28, link.templateLength);
+    }
+}
+
+void
+CramReader::decodeRecord(SliceState &state, int recordIndex,
+                         vector<char> &out) {
+    const auto &series = state.header->dataSeries;
+    auto &streams = state.streams;
+    MateLink link{out.size(), state.refId, 0, 0, 0, -1, -1, 0, 0, true};
+    link.flag = series[BF].decodeInt(streams);
+    auto cramFlag = series[CF].decodeInt(streams);
+    if (state.refId == -2) {
+        link.refId = series[RI].decodeInt(streams);
+    }
+    auto readLength = series[RL].decodeInt(streams);
+    link.alignmentStart = series[AP].decodeInt(streams);
+    if (state.header->positionDeltas) {
+        link.alignmentStart += state.lastPosition;
+        state.lastPosition = link.alignmentStart;
+    }
+    series[RG].decodeInt(streams);
+    if (state.header->readNamesIncluded) {
+        state.scratch.clear();
+        series[RN].decodeByteArray(streams, state.scratch);
+    }
+    if (cramFlag & CRAMDETACHED) {
+        auto mateFlag = series[MF].decodeInt(streams);
+        if (mateFlag & 0x1) {
+            link.flag |= 0x20;
+        }
+        if (mateFlag & 0x2) {
+            link.flag |= 0x8;
+        }
+        if (!state.header->readNamesIncluded) {
+            state.scratch.clear();
+            series[RN].decodeByteArray(streams, state.scratch);
+        }
+        link.mateRefId = series[NS].decodeInt(streams);
+        link.matePos = series[NP].decodeInt(streams);
+        link.templateLength = series[TS].decodeInt(streams);
+    } else if (cramFlag & CRAMMATEDOWNSTREAM) {
+        link.mateLine = recordIndex + 1 + series[NF].decodeInt(streams);
+        link.templateLengthKnown = false;
+    }
+
+    auto tagLine = series[TL].decodeInt(streams);
+    if (tagLine < 0 ||
+        tagLine >= static_cast<int>(state.header->tagLines.size())) {
+        cramFormatError("invalid tag line");
+    }
+    state.tags.clear();
+    for (auto key : state.header->tagLines[tagLine]) {
+        auto encoding = state.header->tagEncodings.find(key);
+        if (encoding == state.header->tagEncodings.end()) {
+            cramFormatError("missing tag encoding");
+        }
+        state.tags.push_back(static_cast<unsigned char>(key >> 16));
+        state.tags.push_back(static_cast<unsigned char>(key >> 8));
+        state.tags.push_back(static_cast<unsigned char>(key));
+        encoding->second.decodeByteArray(streams, state.tags);
+    }
+
+    auto mapped = (link.flag & 0x4) == 0;
+    auto mappingQuality = 0;
+    auto referenceSpan = 0;
+    state.cigar.clear();
+    if (mapped) {
+        decodeFeatures(state);
+        mappingQuality = series[MQ].decodeInt(streams);
+        referenceSpan = buildCigar(state, readLength);
+        link.alignmentEnd =
+            max(link.alignmentStart, link.alignmentStart + referenceSpan - 1);
+    } else {
+        link.alignmentEnd = link.alignmentStart;
+    }
+
+    // core fields and CIGAR first, the mate fields are filled in once the
+    // whole slice is decoded
+    auto sequenceLength = (cramFlag & CRAMNOSEQUENCE) ? 0 : readLength;
+    auto recordStart = out.size();
+    auto cigarEnd = recordStart + 4 + 32 + 2 + 4 * state.cigar.size();
+    out.resize(cigarEnd);
+    auto core = out.data() + recordStart + 4;
+    writeInt32(core, link.refId);
+    writeInt32(core + 4, link.alignmentStart - 1);
+    core[8] = 2;
+    core[9] = static_cast<char>(mappingQuality);
+    writeUint16(core + 10, 0);
+    writeUint16(core + 12, static_cast<int>(state.cigar.size()));
+    writeInt32(core + 16, sequenceLength);
+    memcpy(core + 32, "*", 2);
+    memcpy(core + 34, state.cigar.data(), 4 * state.cigar.size());
+    BamRecord view{};
+    view.assign(core, static_cast<int>(cigarEnd - recordStart - 4));
+    auto eventCandidate = view.isEventCandidate();
+
+    state.qualities.assign(readLength, 0xff);
+    if (mapped) {
+        if (eventCandidate) {
+            reconstructBases(state, link.refId, link.alignmentStart,
+                             readLength);
+        }
+        if (cramFlag & CRAMQUALITYARRAY) {
+            series[QS].decodeByteRun(
+                streams, readLength,
+                eventCandidate ? state.qualities.data() : nullptr);
+        }
+    } else {
+        state.bases.assign(readLength, 'N');
+        if (!(cramFlag & CRAMNOSEQUENCE)) {
+            series[BA].decodeByteRun(
+                streams, readLength,
+                reinterpret_cast<unsigned char *>(&state.bases[0]));
+        }
+        if (cramFlag & CRAMQUALITYARRAY) {
+            series[QS].decodeByteRun(streams, readLength,
+                                     state.qualities.data());
+        }
+    }
+
+    auto tagLength = eventCandidate ? state.tags.size() : 0;
+    auto blockSize = cigarEnd - recordStart - 4 + (sequenceLength + 1) / 2 +
+                     sequenceLength + tagLength;
+    out.resize(recordStart + 4 + blockSize);
+    writeInt32(out.data() + recordStart, static_cast<int32_t>(blockSize));
+    auto packed = reinterpret_cast<unsigned char *>(out.data() + cigarEnd);
+    auto qualities = out.data() + cigarEnd + (sequenceLength + 1) / 2;
+    if (eventCandidate) {
+        for (auto i = 0; i < sequenceLength; ++i) {
+            auto code = BASECODES[static_cast<unsigned char>(state.bases[i])];
+            packed[i / 2] |= (i % 2 == 0) ? code << 4 : code;
+        }
+        memcpy(qualities, state.qualities.data(), sequenceLength);
+        memcpy(qualities + sequenceLength, state.tags.data(), tagLength);
+    }
+    state.links.push_back(link);
+}
+
+void
+CramReader::decodeFeatures(SliceState &state) {
+    const auto &series = state.header->dataSeries;
+    auto &streams = state.streams;
+    state.features.clear();
+    state.featureData.clear();
+    auto featureCount = series[FN].decodeInt(streams);
+    auto position = 0;
+    for (auto i = 0; i < featureCount; ++i) {
+        ReadFeature feature{};
+        feature.code = static_cast<char>(series[FC].decodeByte(streams));
+        position += series[FP].decodeInt(streams);
+        feature.position = position;
+        feature.dataStart = state.featureData.size();
+        switch (feature.code) {
+        case 'B':
+            feature.value = series[BA].decodeByte(streams);
+            feature.quality = series[QS].decodeByte(streams);
+            break;
+        case 'X':
+            feature.value = series[BS].decodeByte(streams);
+            break;
+        case 'I':
+            series[IN].decodeByteArray(streams, state.featureData);
+            break;
+        case 'i':
+            feature.value = series[BA].decodeByte(streams);
+            break;
+        case 'D':
+            feature.value = series[DL].decodeInt(streams);
+            break;
+        case 'N':
+            feature.value = series[RS].decodeInt(streams);
+            break;
+        case 'S':
+            series[SC].decodeByteArray(streams, state.featureData);
+            break;
+        case 'P':
+            feature.value = series[PD].decodeInt(streams);
+            break;
+        case 'H':
+            feature.value = series[HC].decodeInt(streams);
+            break;
+        case 'Q':
+            feature.quality = series[QS].decodeByte(streams);
+            break;
+        case 'b':
+            series[BB].decodeByteArray(streams, state.featureData);
+            break;
+        case 'q':
+            series[QQ].decodeByteArray(streams, state.featureData);
+            break;
+        default:
+            cramFormatError(string{"unknown read feature "} + feature.code);
+        }
+        feature.dataLength =
+            static_cast<int>(state.featureData.size() - feature.dataStart);
+        state.features.push_back(feature);
+    }
+}
+
+int
+CramReader::buildCigar(SliceState &state, int readLength) const {
+    auto readPosition = 1;
+    auto referenceSpan = 0;
+    for (const auto &feature : state.features) {
+        if (feature.position > readPosition) {
+            addCigarOperation(state.cigar, CIGARM,
+                              feature.position - readPosition);
+            referenceSpan += feature.position - readPosition;
+            readPosition = feature.position;
+        }
+        switch (feature.code) {
+        case 'X':
+        case 'B':
+            addCigarOperation(state.cigar, CIGARM, 1);
+            ++readPosition;
+            ++referenceSpan;
+            break;
+        case 'b':
+            addCigarOperation(state.cigar, CIGARM, feature.dataLength);
+            readPosition += feature.dataLength;
+            referenceSpan += feature.dataLength;
+            break;
+        case 'I':
+            addCigarOperation(state.cigar, CIGARI, feature.dataLength);
+            readPosition += feature.dataLength;
+            break;
+        case 'i':
+            addCigarOperation(state.cigar, CIGARI, 1);
+            ++readPosition;
+            break;
+        case 'S':
+            addCigarOperation(state.cigar, CIGARS, feature.dataLength);
+            readPosition += feature.dataLength;
+            break;
+        case 'D':
+            addCigarOperation(state.cigar, CIGARD, feature.value);
+            referenceSpan += feature.value;
+            break;
+        case 'N':
+            addCigarOperation(state.cigar, CIGARN, feature.value);
+            referenceSpan += feature.value;
+            break;
+        case 'P':
+            addCigarOperation(state.cigar, CIGARP, feature.value);
+            break;
+        case 'H':
+            addCigarOperation(state.cigar, CIGARH, feature.value);
+            break;
+        default:
+            break;
+        }
+    }
+    if (readPosition <= readLength) {
+        addCigarOperation(state.cigar, CIGARM, readLength - readPosition + 1);
+        referenceSpan += readLength - readPosition + 1;
+    }
+    return referenceSpan;
+}
+
+// Compares the reference MD5 of a single reference slice with the bases the
+// --reference FASTA has over its span, so that reads are never reconstructed
+// against the wrong assembly. Slices without an MD5 (all zeros) and slices
+// carrying their own reference are not checked.
+void
+CramReader::checkReferenceMd5(SliceState &state, int start, int span,
+                              const unsigned char *md5) {
+    if (state.embeddedReference != nullptr || referenceFasta == nullptr ||
+        state.refId < 0 ||
+        state.refId >= static_cast<int>(getReferenceNames().size()) ||
+        all_of(md5, md5 + 16, [](unsigned char c) { return c == 0; })) {
+        return;
+    }
+    if (state.fastaRefId != state.refId) {
+        state.fastaSequence =
+            referenceFasta->getSequence(getReferenceNames()[state.refId]);
+        state.fastaRefId = state.refId;
+    }
+    const auto &sequence = *state.fastaSequence;
+    auto first = min(static_cast<size_t>(max(start - 1, 0)), sequence.size());
+    auto length =
+        min(static_cast<size_t>(max(span, 0)), sequence.size() - first);
+    auto digest = md5Digest(sequence.data() + first, length);
+    if (!equal(digest.begin(), digest.end(), md5)) {
+        cramFormatError("slice reference MD5 does not match --reference at " +
+                        getReferenceNames()[state.refId] + ":" +
+                        to_string(start) + "-" + to_string(start + span - 1));
+    }
+}
+
+void
+CramReader::reconstructBases(SliceState &state, int refId, int position,
+                             int readLength) {
+    if (state.embeddedReference == nullptr) {
+        if (referenceFasta != nullptr && refId >= 0 &&
+            refId < static_cast<int>(getReferenceNames().size())) {
+            if (state.fastaRefId != refId) {
+                state.fastaSequence =
+                    referenceFasta->getSequence(getReferenceNames()[refId]);
+                state.fastaRefId = refId;
+            }
+        } else if (state.header->referenceRequired) {
+            cramFormatError("reference based CRAM input needs a reference "
+                            "FASTA (--reference)");
+        }
+    }
+    state.bases.assign(readLength, 'N');
+    auto readIndex = 0;
+    long referencePosition = position - 1;
+    auto copyReference = [&](int length) {
+        for (auto i = 0; i < length && readIndex < readLength; ++i) {
+            state.bases[readIndex++] =
+                referenceBase(state, referencePosition++);
+        }
+    };
+    auto copyData = [&](const ReadFeature &feature) {
+        for (auto i = 0; i < feature.dataLength && readIndex < readLength;
+             ++i) {
+            state.bases[readIndex++] = static_cast<char>(
+                state.featureData[feature.dataStart + i]);
+        }
+    };
+    for (const auto &feature : state.features) {
+        if (feature.position - 1 > readIndex) {
+            copyReference(feature.position - 1 - readIndex);
+        }
+        switch (feature.code) {
+        case 'X':
+            if (readIndex < readLength) {
+                state.bases[readIndex++] =
+                    state.header->substitutions[substitutionRow(
+                        referenceBase(state, referencePosition))]
+                                               [feature.value & 3];
+            }
+            ++referencePosition;
+            break;
+        case 'B':
+            if (readIndex < readLength) {
+                state.bases[readIndex] = static_cast<char>(feature.value);
+                state.qualities[readIndex] =
+                    static_cast<unsigned char>(feature.quality);
+                ++readIndex;
+            }
+            ++referencePosition;
+            break;
+        case 'b':
+            copyData(feature);
+            referencePosition += feature.dataLength;
+            break;
+        case 'I':
+        case 'S':
+            copyData(feature);
+            break;
+        case 'i':
+            if (readIndex < readLength) {
+                state.bases[readIndex++] = static_cast<char>(feature.value);
+            }
+            break;
+        case 'D':
+        case 'N':
+            referencePosition += feature.value;
+            break;
+        case 'Q':
+            if (feature.position >= 1 && feature.position <= readLength) {
+                state.qualities[feature.position - 1] =
+                    static_cast<unsigned char>(feature.quality);
+            }
+            break;
+        case 'q':
+            for (auto i = 0; i < feature.dataLength &&
+                             feature.position - 1 + i < readLength;
+                 ++i) {
+                state.qualities[feature.position - 1 + i] =
+                    state.featureData[feature.dataStart + i];
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    copyReference(readLength - readIndex);
+}
+
+char
+CramReader::referenceBase(const SliceState &state, long position) const {
+    const string *sequence{nullptr};
+    auto offset = 0L;
+    if (state.embeddedReference != nullptr) {
+        const auto &data = state.embeddedReference->getData();
+        offset = position - (state.embeddedReferenceStart - 1);
+        if (offset >= 0 && offset < static_cast<long>(data.size())) {
+            return static_cast<char>(toupper(data[offset]));
+        }
+        return 'N';
+    }
+    sequence = state.fastaSequence.get();
+    offset = position;
+    if (sequence == nullptr || offset < 0 ||
+        offset >= static_cast<long>(sequence->size())) {
+        return 'N';
+    }
+    return (*sequence)[offset];
+}
+
+void
+CramReader::resolveMates(vector<MateLink> &links) {
+    // mates within the slice are linked by record index: fill in the mate
+    // position, the mate flags and the template length like samtools does
+    auto recordCount = static_cast<int>(links.size());
+    for (auto record = 0; record < recordCount; ++record) {
+        auto &link = links[record];
+        if (link.mateLine < 0) {
+            continue;
+        }
+        if (link.mateLine >= recordCount) {
+            cramFormatError("mate record out of slice");
+        }
+        if (!link.templateLengthKnown) {
+            auto leftmost = link.alignmentStart;
+            auto rightmost = link.alignmentEnd;
+            auto refId = link.refId;
+            auto leftmostCount = 0;
+            auto current = record;
+            while (true) {
+                auto &segment = links[current];
+                if (leftmost > segment.alignmentStart) {
+                    leftmost = segment.alignmentStart;
+                    leftmostCount = 1;
+                } else if (leftmost == segment.alignmentStart) {
+                    ++leftmostCount;
+                }
+                rightmost = max(rightmost, segment.alignmentEnd);
+                if (segment.mateLine == -1) {
+                    // the last segment of the template points back
+                    segment.mateLine = record;
+                    break;
+                }
+                if (segment.mateLine <= current ||
+                    segment.mateLine >= recordCount) {
+                    cramFormatError("invalid mate chain");
+                }
+                current = segment.mateLine;
+                if (links[current].refId != refId) {
+                    refId = -1;
+                }
+            }
+            auto templateLength = refId == -1 ? 0 : rightmost - leftmost + 1;
+            current = record;
+            do {
+                auto &segment = links[current];
+                if (segment.alignmentStart == leftmost &&
+                    (leftmostCount == 1 || (segment.flag & 0x40))) {
+                    segment.templateLength = templateLength;
+                } else {
+                    segment.templateLength = -templateLength;
+                }
+                segment.templateLengthKnown = true;
+                current = segment.mateLine;
+            } while (current != record);
+        }
+        const auto &mate = links[link.mateLine];
+        link.mateRefId = mate.refId;
+        link.matePos = mate.alignmentStart;
+        link.flag |= 0x1;
+        if (mate.flag & 0x4) {
+            link.flag |= 0x8;
+            link.templateLength = 0;
+        }
+        if (link.flag & 0x4) {
+            link.templateLength = 0;
+        }
+        if (mate.flag & 0x10) {
+            link.flag |= 0x20;
+        }
+    }
+}
+
+unsigned char
+CramReader::readFileByte() {
+    auto value = fgetc(fileHandle);
+    if (value == EOF) {
+        cramFormatError("unexpected end of file " + fileName);
+    }
+    return static_cast<unsigned char>(value);
+}
+
+int32_t
+CramReader::readFileItf8() {
+    unsigned char bytes[5];
+    bytes[0] = readFileByte();
+    auto extraBytes = 0;
+    while (extraBytes < 4 && (bytes[0] & (0x80 >> extraBytes)) != 0) {
+        bytes[++extraBytes] = readFileByte();
+    }
+    CramByteReader reader{bytes, bytes + 1 + extraBytes};
+    return reader.readItf8();
+}
+
+int64_t
+CramReader::readFileLtf8() {
+    unsigned char bytes[9];
+    bytes[0] = readFileByte();
+    auto extraBytes = 0;
+    while (extraBytes < 8 && (bytes[0] & (0x80 >> extraBytes)) != 0) {
+        bytes[++extraBytes] = readFileByte();
+    }
+    CramByteReader reader{bytes, bytes + 1 + extraBytes};
+    return reader.readLtf8();
+}
+
+} /* namespace sophia */
@@ -0,0 +1,78 @@
+/*
+ * DepthTrack.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "DepthTrack.h"
+#include "ChrConverter.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace sophia {
+
+using namespace std;
+
+DepthTrack::DepthTrack(const string &fileName, int binSizeIn)
+    : BINSIZE{max(1, binSizeIn)}, writer{fileName}, chrIndex{0},
+      binStart{-1}, coverageSum{0}, normalSpansSum{0}, lowQualSpansSum{0} {
+    writer.write("#chr\tstart\tend\tcoverage\tnormalSpans\tlowQualSpans\n");
+}
+
+void
+DepthTrack::add(int chrIndexIn, const CoverageWindow &window, int startPos,
+                int endPos) {
+    for (auto pos = startPos; pos < endPos;) {
+        // the positions are one based, bedGraph is zero based
+        if (binStart == -1 || chrIndexIn != chrIndex ||
+            pos > binStart + BINSIZE) {
+            writeBin();
+            chrIndex = chrIndexIn;
+            binStart = (pos - 1) - (pos - 1) % BINSIZE;
+        }
+        auto binEnd = min(endPos, binStart + BINSIZE + 1);
+        for (; pos < binEnd; ++pos) {
+            coverageSum += window.getCoverage(pos);
+            normalSpansSum += window.getNormalSpans(pos);
+            lowQualSpansSum += window.getLowQualSpansSoft(pos) +
+                               window.getLowQualSpansHard(pos);
+        }
+    }
+}
+
+void
+DepthTrack::writeBin() {
+    if (binStart == -1) {
+        return;
+    }
+    char line[256];
+    auto length = snprintf(
+        line, sizeof(line), "%s\t%d\t%d\t%.2f\t%.2f\t%.2f\n",
+        ChrConverter::indexToChr[chrIndex].c_str(), binStart,
+        binStart + BINSIZE, coverageSum / static_cast<double>(BINSIZE),
+        normalSpansSum / static_cast<double>(BINSIZE),
+        lowQualSpansSum / static_cast<double>(BINSIZE));
+    writer.write(line, length);
+    binStart = -1;
+    coverageSum = 0;
+    normalSpansSum = 0;
+    lowQualSpansSum = 0;
+}
+
+} /* namespace sophia */
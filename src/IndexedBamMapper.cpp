@@ -0,0 +1,192 @@
+/*
+ * IndexedBamMapper.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "IndexedBamMapper.h"
+#include "BamReader.h"
+#include "SamSegmentMapper.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <thread>
+
+namespace sophia {
+
+using namespace std;
+
+namespace {
+
+// the records of a range of references of a BAM file positioned with its
+// index. Stretches that the read filter drops entirely are skipped by seeking
+// past them, the records left in them are read and dropped.
+class ReferenceRangeReader : public RecordReader {
+  public:
+    ReferenceRangeReader(BamReader &bamReaderIn, const BamIndex &indexIn,
+                         ReadFilter &readFilterIn, int firstRefIdIn,
+                         int lastRefIdIn)
+        : bamReader{bamReaderIn}, index{indexIn}, readFilter{readFilterIn},
+          firstRefId{firstRefIdIn}, lastRefId{lastRefIdIn} {
+        for (const auto &name : bamReader.getReferenceNames()) {
+            addReference(name);
+        }
+    }
+    bool nextRecord(BamRecord &record) override {
+        while (bamReader.nextRecord(record)) {
+            auto refId = record.getRefId();
+            // the first chunk may start with records of earlier references
+            if (refId < firstRefId) {
+                continue;
+            }
+            // unplaced reads are sorted to the very end
+            if (refId < 0 || refId > lastRefId) {
+                return false;
+            }
+            if (!readFilter.filtersPositions()) {
+                return true;
+            }
+            auto next = readFilter.nextPassingPosition(
+                getReferenceNames()[refId], record.getPos());
+            if (next == record.getPos()) {
+                return true;
+            }
+            auto offset = next == INT_MAX ? firstOffsetAfter(refId)
+                                          : index.getOffset(refId, next);
+            if (next == INT_MAX && offset == 0) {
+                return false;
+            }
+            if ((offset >> 16) > (bamReader.tell() >> 16)) {
+                bamReader.seek(offset);
+            }
+        }
+        return false;
+    }
+
+  private:
+    uint64_t firstOffsetAfter(int refId) const {
+        for (auto nextRefId = refId + 1; nextRefId <= lastRefId; ++nextRefId) {
+            auto offset = index.getFirstOffset(nextRefId);
+            if (offset != 0) {
+                return offset;
+            }
+        }
+        return 0;
+    }
+    BamReader &bamReader;
+    const BamIndex &index;
+    ReadFilter &readFilter;
+    const int firstRefId, lastRefId;
+};
+
+} // namespace
+
+IndexedBamMapper::IndexedBamMapper(const string &fileNameIn,
+                                   const ReadParameters &readParametersIn,
+                                   int threadsIn,
+                                   const ReadFilter &readFilterIn)
+    : fileName{fileNameIn}, readParameters{readParametersIn},
+      THREADS{max(1, threadsIn)}, readFilter{readFilterIn}, index{fileName},
+      groups{}, nextGroup{0} {
+    BamReader headerReader{fileName, 1};
+    auto contigFilter = readFilter;
+    auto lastChrIndex = -1;
+    auto referenceCount =
+        static_cast<int>(headerReader.getReferenceNames().size());
+    for (auto refId = 0; refId < referenceCount; ++refId) {
+        // references that are filtered out do not end a group, as the
+        // sequential run never sees their reads
+        auto chrIndex = headerReader.toChrIndex(refId);
+        if (chrIndex > 1000 ||
+            contigFilter.nextPassingPosition(
+                headerReader.getReferenceNames()[refId], 0) == INT_MAX) {
+            continue;
+        }
+        auto firstOffset = index.getFirstOffset(refId);
+        if (chrIndex == lastChrIndex) {
+            groups.back().lastRefId = refId;
+            if (groups.back().firstOffset == 0) {
+                groups.back().firstOffset = firstOffset;
+            }
+        } else {
+            groups.push_back(
+                ChromosomeGroup{refId, refId, firstOffset, nullptr, false});
+            lastChrIndex = chrIndex;
+        }
+    }
+}
+
+void
+IndexedBamMapper::run() {
+    vector<thread> threadPool;
+    for (auto i = 0; i < THREADS; ++i) {
+        threadPool.emplace_back(&IndexedBamMapper::workerLoop, this);
+    }
+    auto indexOffset = 0;
+    for (auto &group : groups) {
+        {
+            unique_lock<mutex> lock{queueMutex};
+            groupDone.wait(lock, [&group] { return group.done; });
+        }
+        group.output->flush(indexOffset);
+        indexOffset += group.output->getIndexCount();
+        group.output.reset();
+    }
+    for (auto &worker : threadPool) {
+        worker.join();
+    }
+}
+
+void
+IndexedBamMapper::workerLoop() {
+    while (true) {
+        ChromosomeGroup *group{nullptr};
+        {
+            lock_guard<mutex> lock{queueMutex};
+            if (nextGroup == groups.size()) {
+                return;
+            }
+            group = &groups[nextGroup++];
+        }
+        mapGroup(*group);
+        {
+            lock_guard<mutex> lock{queueMutex};
+            group->done = true;
+        }
+        groupDone.notify_all();
+    }
+}
+
+void
+IndexedBamMapper::mapGroup(ChromosomeGroup &group) const {
+    group.output = make_unique<BreakpointOutput>(true, cout);
+    // a group without records in the index has nothing to report
+    if (group.firstOffset == 0) {
+        return;
+    }
+    BamReader bamReader{fileName, 1};
+    bamReader.seek(group.firstOffset);
+    auto groupFilter = readFilter;
+    ReferenceRangeReader rangeReader{bamReader, index, groupFilter,
+                                     group.firstRefId, group.lastRefId};
+    SamSegmentMapper mapper{readParameters, 1, *group.output, nullptr, nullptr,
+                            nullptr};
+    mapper.parseRecordStream(rangeReader, groupFilter);
+}
+
+} /* namespace sophia */
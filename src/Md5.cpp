@@ -0,0 +1,125 @@
+/*
+ * Md5.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "Md5.h"
+#include <cstdint>
+#include <cstring>
+
+namespace sophia {
+
+using namespace std;
+
+namespace {
+
+const uint32_t ROUNDCONSTANTS[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
+    0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340,
+    0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8,
+    0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+    0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92,
+    0xffeff47d, 0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+const int SHIFTS[64] = {7,  12, 17, 22, 7,  12, 17, 22, 7,  12, 17, 22, 7,
+                        12, 17, 22, 5,  9,  14, 20, 5,  9,  14, 20, 5,  9,
+                        14, 20, 5,  9,  14, 20, 4,  11, 16, 23, 4,  11, 16,
+                        23, 4,  11, 16, 23, 4,  11, 16, 23, 6,  10, 15, 21,
+                        6,  10, 15, 21, 6,  10, 15, 21, 6,  10, 15, 21};
+
+void
+processChunk(const unsigned char *chunk, uint32_t state[4]) {
+    uint32_t words[16];
+    for (auto i = 0; i < 16; ++i) {
+        words[i] = static_cast<uint32_t>(chunk[4 * i]) |
+                   static_cast<uint32_t>(chunk[4 * i + 1]) << 8 |
+                   static_cast<uint32_t>(chunk[4 * i + 2]) << 16 |
+                   static_cast<uint32_t>(chunk[4 * i + 3]) << 24;
+    }
+    auto a = state[0];
+    auto b = state[1];
+    auto c = state[2];
+    auto d = state[3];
+    for (auto i = 0; i < 64; ++i) {
+        uint32_t f;
+        int g;
+        if (i < 16) {
+            f = (b & c) | (~b & d);
+            g = i;
+        } else if (i < 32) {
+            f = (d & b) | (~d & c);
+            g = (5 * i + 1) % 16;
+        } else if (i < 48) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) % 16;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) % 16;
+        }
+        f += a + ROUNDCONSTANTS[i] + words[g];
+        a = d;
+        d = c;
+        c = b;
+        b += (f << SHIFTS[i]) | (f >> (32 - SHIFTS[i]));
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+} // namespace
+
+array<unsigned char, 16>
+md5Digest(const char *data, size_t length) {
+    uint32_t state[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+    auto bytes = reinterpret_cast<const unsigned char *>(data);
+    auto fullChunks = length / 64;
+    for (size_t i = 0; i < fullChunks; ++i) {
+        processChunk(bytes + 64 * i, state);
+    }
+    // the remaining bytes, the 0x80 terminator and the bit length, padded to
+    // one or two chunks
+    unsigned char tail[128] = {};
+    auto remaining = length % 64;
+    memcpy(tail, bytes + 64 * fullChunks, remaining);
+    tail[remaining] = 0x80;
+    auto tailLength = remaining < 56 ? 64 : 128;
+    auto bitLength = static_cast<uint64_t>(length) * 8;
+    for (auto i = 0; i < 8; ++i) {
+        tail[tailLength - 8 + i] =
+            static_cast<unsigned char>(bitLength >> (8 * i));
+    }
+    processChunk(tail, state);
+    if (tailLength == 128) {
+        processChunk(tail + 64, state);
+    }
+    array<unsigned char, 16> digest;
+    for (auto i = 0; i < 16; ++i) {
+        digest[i] = static_cast<unsigned char>(state[i / 4] >> (8 * (i % 4)));
+    }
+    return digest;
+}
+
+} /* namespace sophia */
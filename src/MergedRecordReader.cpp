@@ -0,0 +1,184 @@
+/*
+ * MergedRecordReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "MergedRecordReader.h"
+#include "HelperFunctions.h"
+#include <iostream>
+
+namespace sophia {
+
+using namespace std;
+
+MergedRecordReader::MergedRecordReader(
+    vector<unique_ptr<RecordReader>> inputsIn)
+    : sources{}, heap{}, lastSource{-1}, shuttingDown{false}, threadPool{} {
+    const auto &referenceNames = inputsIn.front()->getReferenceNames();
+    for (auto &input : inputsIn) {
+        if (input->getReferenceNames() != referenceNames) {
+            cerr << "Error: the inputs to merge have different references"
+                 << endl;
+            exit(EXITCODE_IOERROR);
+        }
+        sources.push_back(Source{move(input), {}, {}, {}, false, nullptr, 0,
+                                 BamRecord{}});
+        for (auto i = 0; i < CHUNKSPERINPUT; ++i) {
+            sources.back().chunkPool.push_back(make_unique<Chunk>());
+            sources.back().freeChunks.push_back(
+                sources.back().chunkPool.back().get());
+        }
+    }
+    for (const auto &name : referenceNames) {
+        addReference(name);
+    }
+    for (auto &source : sources) {
+        threadPool.emplace_back(&MergedRecordReader::readLoop, this,
+                                ref(source));
+    }
+    for (auto i = 0; i < static_cast<int>(sources.size()); ++i) {
+        if (advance(sources[i])) {
+            heap.push(HeapEntry{sortKey(sources[i].front), i});
+        }
+    }
+}
+
+MergedRecordReader::~MergedRecordReader() {
+    {
+        lock_guard<mutex> lock{queueMutex};
+        shuttingDown = true;
+    }
+    slotAvailable.notify_all();
+    for (auto &reader : threadPool) {
+        reader.join();
+    }
+}
+
+bool
+MergedRecordReader::nextRecord(BamRecord &record) {
+    // the record handed out last stays valid until now
+    if (lastSource != -1 && advance(sources[lastSource])) {
+        heap.push(
+            HeapEntry{sortKey(sources[lastSource].front), lastSource});
+    }
+    if (heap.empty()) {
+        lastSource = -1;
+        return false;
+    }
+    lastSource = heap.top().source;
+    heap.pop();
+    record = sources[lastSource].front;
+    return true;
+}
+
+uint64_t
+MergedRecordReader::sortKey(const BamRecord &record) {
+    // unplaced reads come last
+    if (record.getRefId() < 0) {
+        return UINT64_MAX;
+    }
+    return (static_cast<uint64_t>(record.getRefId()) << 32 |
+            static_cast<uint32_t>(record.getPos() + 1))
+               << 1 |
+           ((record.getFlag() & 0x10) != 0);
+}
+
+void
+MergedRecordReader::readLoop(Source &source) {
+    BamRecord record;
+    while (true) {
+        Chunk *chunk{nullptr};
+        {
+            unique_lock<mutex> lock{queueMutex};
+            slotAvailable.wait(lock, [this, &source] {
+                return !source.freeChunks.empty() || shuttingDown;
+            });
+            if (shuttingDown) {
+                return;
+            }
+            chunk = source.freeChunks.back();
+            source.freeChunks.pop_back();
+        }
+        chunk->recordData.clear();
+        chunk->recordStarts.clear();
+        chunk->recordChrIndices.clear();
+        chunk->recordMateChrIndices.clear();
+        auto endOfInput = false;
+        while (chunk->recordStarts.size() < CHUNKSIZE) {
+            if (!source.reader->nextRecord(record)) {
+                endOfInput = true;
+                break;
+            }
+            chunk->recordStarts.push_back(
+                static_cast<int>(chunk->recordData.size()));
+            chunk->recordData.insert(chunk->recordData.end(), record.getData(),
+                                     record.getData() + record.getLength());
+            chunk->recordChrIndices.push_back(record.getChrIndex());
+            chunk->recordMateChrIndices.push_back(record.getMateChrIndex());
+        }
+        {
+            lock_guard<mutex> lock{queueMutex};
+            if (chunk->recordStarts.empty()) {
+                source.freeChunks.push_back(chunk);
+            } else {
+                source.filledChunks.push_back(chunk);
+            }
+            source.endOfInput = endOfInput;
+        }
+        chunkReady.notify_all();
+        if (endOfInput) {
+            return;
+        }
+    }
+}
+
+bool
+MergedRecordReader::advance(Source &source) {
+    while (source.currentChunk == nullptr ||
+           source.currentIndex == source.currentChunk->recordStarts.size()) {
+        unique_lock<mutex> lock{queueMutex};
+        if (source.currentChunk != nullptr) {
+            source.freeChunks.push_back(source.currentChunk);
+            source.currentChunk = nullptr;
+            slotAvailable.notify_all();
+        }
+        chunkReady.wait(lock, [&source] {
+            return !source.filledChunks.empty() || source.endOfInput;
+        });
+        if (source.filledChunks.empty()) {
+            return false;
+        }
+        source.currentChunk = source.filledChunks.front();
+        source.filledChunks.pop_front();
+        source.currentIndex = 0;
+    }
+    const auto &chunk = *source.currentChunk;
+    auto i = source.currentIndex++;
+    auto end = i + 1 < chunk.recordStarts.size()
+                   ? chunk.recordStarts[i + 1]
+                   : static_cast<int>(chunk.recordData.size());
+    source.front.assign(chunk.recordData.data() + chunk.recordStarts[i],
+                             end - chunk.recordStarts[i]);
+    source.front.setChrIndices(chunk.recordChrIndices[i],
+                                    chunk.recordMateChrIndices[i]);
+    return true;
+}
+
+} /* namespace sophia */
@@ -0,0 +1,112 @@
+/*
+ * PackedOverhang.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+
+#include "PackedOverhang.h"
+
+namespace sophia {
+
+using namespace std;
+
+PackedOverhang::PackedOverhang(const Alignment &alignment)
+    : encounteredM{alignment.isOverhangEncounteredM()},
+      length{alignment.getOverhangLength()},
+      planes((length + WORDBASES - 1) / WORDBASES * PLANES, 0),
+      otherBases{} {
+    const auto &samLine = alignment.getSamLine();
+    auto start = alignment.getOverhangStartIndex();
+    // a left overhang ends at the breakpoint
+    auto baseAtRead = [&](int i) {
+        return samLine[encounteredM ? start + i : start + length - 1 - i];
+    };
+    for (auto i = 0; i < length; ++i) {
+        auto *word = &planes[i / WORDBASES * PLANES];
+        auto bit = uint64_t{1} << (i % WORDBASES);
+        switch (baseAtRead(i)) {
+        case 'A':
+            break;
+        case 'C':
+            word[0] |= bit;
+            break;
+        case 'G':
+            word[1] |= bit;
+            break;
+        case 'T':
+            word[0] |= bit;
+            word[1] |= bit;
+            break;
+        case 'N':
+            word[2] |= bit;
+            break;
+        default:
+            for (auto j = 0; j < length; ++j) {
+                otherBases.push_back(baseAtRead(j));
+            }
+            return;
+        }
+    }
+}
+
+int
+PackedOverhang::countMismatches(const PackedOverhang &shorter,
+                                int limit) const {
+    auto mismatches = 0;
+    if (!otherBases.empty() || !shorter.otherBases.empty()) {
+        for (auto i = 0; i < shorter.length && mismatches <= limit; ++i) {
+            auto base = getBase(i);
+            auto shorterBase = shorter.getBase(i);
+            if (base != 'N' && shorterBase != 'N' && base != shorterBase) {
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+    for (auto start = 0; start < shorter.length && mismatches <= limit;
+         start += WORDBASES) {
+        const auto *word = &planes[start / WORDBASES * PLANES];
+        const auto *shorterWord = &shorter.planes[start / WORDBASES * PLANES];
+        auto compared = ~(word[2] | shorterWord[2]);
+        if (shorter.length - start < WORDBASES) {
+            compared &= (uint64_t{1} << (shorter.length - start)) - 1;
+        }
+        auto differing =
+            ((word[0] ^ shorterWord[0]) | (word[1] ^ shorterWord[1])) &
+            compared;
+        mismatches += __builtin_popcountll(differing);
+    }
+    return mismatches;
+}
+
+char
+PackedOverhang::getBase(int i) const {
+    if (!otherBases.empty()) {
+        return otherBases[i];
+    }
+    const auto *word = &planes[i / WORDBASES * PLANES];
+    auto bit = i % WORDBASES;
+    if ((word[2] >> bit) & 1) {
+        return 'N';
+    }
+    return "ACGT"[((word[0] >> bit) & 1) | ((word[1] >> bit) & 1) << 1];
+}
+
+} /* namespace sophia */
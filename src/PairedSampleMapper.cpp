@@ -0,0 +1,84 @@
+/*
+ * PairedSampleMapper.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "PairedSampleMapper.h"
+#include <algorithm>
+#include <array>
+
+namespace sophia {
+
+using namespace std;
+
+PairedSampleMapper::PairedSampleMapper(
+    const ReadParameters &tumourReadParametersIn,
+    const ReadParameters &controlReadParametersIn, int threadsIn,
+    BreakpointOutput &tumourOutputIn, BreakpointOutput &controlOutputIn,
+    DepthTrack *tumourDepthTrackIn, DepthTrack *controlDepthTrackIn,
+    WindowBudget *tumourWindowBudgetIn, WindowBudget *controlWindowBudgetIn)
+    : THREADS{max(1, threadsIn)},
+      tumourMapper{tumourReadParametersIn, THREADS, tumourOutputIn,
+                   tumourDepthTrackIn, tumourWindowBudgetIn, nullptr},
+      controlMapper{controlReadParametersIn, THREADS, controlOutputIn,
+                    controlDepthTrackIn, controlWindowBudgetIn, nullptr},
+      chromosomeRanks{}, rankedChromosomes{0} {}
+
+void
+PairedSampleMapper::run(const ReadBatchPipeline::BatchFiller &fillTumour,
+                        const ReadBatchPipeline::BatchFiller &fillControl) {
+    ReadBatchPipeline pipeline{{fillTumour, fillControl},
+                               {&tumourMapper.getReadParameters(),
+                                &controlMapper.getReadParameters()},
+                               THREADS};
+    array<SamSegmentMapper *, 2> mappers{&tumourMapper, &controlMapper};
+    array<const ReadBatch *, 2> batches{pipeline.next(0), pipeline.next(1)};
+    while (batches[0] != nullptr || batches[1] != nullptr) {
+        auto input = 0;
+        if (batches[0] == nullptr) {
+            input = 1;
+        } else if (batches[1] != nullptr &&
+                   batchPosition(*batches[1]) < batchPosition(*batches[0])) {
+            input = 1;
+        }
+        mappers[input]->consumeBatch(*batches[input]);
+        batches[input] = pipeline.next(input);
+    }
+    tumourMapper.finish();
+    controlMapper.finish();
+}
+
+pair<int, int>
+PairedSampleMapper::batchPosition(const ReadBatch &batch) {
+    if (batch.getReads().empty()) {
+        return {-1, -1};
+    }
+    const auto &read = batch.getReads().front().read;
+    auto chrIndex = read.getChrIndex();
+    if (chrIndex >= static_cast<int>(chromosomeRanks.size())) {
+        chromosomeRanks.resize(chrIndex + 1, -1);
+    }
+    if (chromosomeRanks[chrIndex] == -1) {
+        chromosomeRanks[chrIndex] = rankedChromosomes++;
+    }
+    return {chromosomeRanks[chrIndex], read.getStartPos()};
+}
+
+} /* namespace sophia */
@@ -0,0 +1,112 @@
+/*
+ * QualityHistogram.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "QualityHistogram.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace sophia {
+
+using namespace std;
+
+double
+QualityHistogram::median(const char *begin, const char *end,
+                         int lowThreshold) {
+    auto length = end - begin;
+    if (length <= 0) {
+        return -1.0;
+    }
+    // qualities are compared as signed chars, bin 128 holds quality 0
+    array<uint32_t, 256> histogram{};
+    auto lowRun = 0;
+    auto lowestBin = 255;
+    auto i = 0L;
+#if defined(__x86_64__)
+    if (lowThreshold > -128 && lowThreshold < 128) {
+        const auto threshold = _mm_set1_epi8(static_cast<char>(lowThreshold));
+        // flipping the sign bit turns qualities into their bins
+        const auto signBit = _mm_set1_epi8(static_cast<char>(0x80));
+        auto lowestBins = _mm_set1_epi8(static_cast<char>(0xFF));
+        for (; i + 16 <= length; i += 16) {
+            auto chunk =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin + i));
+            auto lowMask = static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmplt_epi8(chunk, threshold)));
+            // the run carried over from the last chunk goes below bit 0
+            auto runs = (lowMask << lowRun) | ((1u << lowRun) - 1);
+            for (auto step = 0; step < MAXLOWRUN; ++step) {
+                runs &= runs >> 1;
+            }
+            if (runs != 0) {
+                return -1.0;
+            }
+            // a chunk without a low run has a high quality base
+            lowRun = __builtin_clz(~lowMask & 0xFFFFu) - 16;
+            lowestBins =
+                _mm_min_epu8(lowestBins, _mm_xor_si128(chunk, signBit));
+            for (auto j = i; j < i + 16; ++j) {
+                ++histogram[static_cast<signed char>(begin[j]) + 128];
+            }
+        }
+        lowestBins = _mm_min_epu8(lowestBins, _mm_srli_si128(lowestBins, 8));
+        lowestBins = _mm_min_epu8(lowestBins, _mm_srli_si128(lowestBins, 4));
+        lowestBins = _mm_min_epu8(lowestBins, _mm_srli_si128(lowestBins, 2));
+        lowestBins = _mm_min_epu8(lowestBins, _mm_srli_si128(lowestBins, 1));
+        lowestBin = _mm_cvtsi128_si32(lowestBins) & 0xFF;
+    }
+#endif
+    for (; i < length; ++i) {
+        if (begin[i] < lowThreshold) {
+            if (lowRun == MAXLOWRUN) {
+                return -1.0;
+            }
+            ++lowRun;
+        } else {
+            lowRun = 0;
+        }
+        auto bin = static_cast<signed char>(begin[i]) + 128;
+        lowestBin = min(lowestBin, bin);
+        ++histogram[bin];
+    }
+    // for even lengths the upper middle is averaged with the lower middle
+    auto middleRank = static_cast<uint32_t>(length / 2);
+    auto belowBin = 0u;
+    auto bin = lowestBin;
+    while (belowBin + histogram[bin] <= middleRank) {
+        belowBin += histogram[bin];
+        ++bin;
+    }
+    auto middle = bin - 128;
+    if (length % 2 != 0 || belowBin < middleRank) {
+        return middle;
+    }
+    auto lowerBin = bin - 1;
+    while (histogram[lowerBin] == 0) {
+        --lowerBin;
+    }
+    return (middle + lowerBin - 128) / 2.0;
+}
+
+} /* namespace sophia */
@@ -0,0 +1,211 @@
+/*
+ * ReadBatch.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "ReadBatch.h"
+#include "SamTokenizer.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+
+namespace sophia {
+
+using namespace std;
+
+ReadBatch::ReadBatch(const ReadParameters &readParametersIn)
+    : readParameters{readParametersIn}, lines{}, lineBlocks{}, recordData{},
+      recordStarts{}, recordChrIndices{}, recordMateChrIndices{},
+      recordOffsets{}, fieldTabs{}, reads{}, alignmentPool{},
+      alignmentPoolCursor{0} {
+    fieldTabs.reserve(CompactAlignment::FIELDTABS);
+    reads.reserve(CAPACITY);
+}
+
+bool
+ReadBatch::fill(SamLineReader &lineReader, ReadFilter &readFilter) {
+    string_view line;
+    auto filtered = readFilter.isActive();
+    while (lines.size() < CAPACITY && lineReader.nextLine(line)) {
+        if (line.empty() || (filtered && !passesFilter(line, readFilter))) {
+            continue;
+        }
+        // the block is only looked up again once a line lies outside the last
+        // one, as held blocks are never overwritten
+        if (lineBlocks.empty() || line.data() < lineBlocks.back()->data() ||
+            line.data() >=
+                lineBlocks.back()->data() + lineBlocks.back()->size()) {
+            lineBlocks.push_back(lineReader.getBlock());
+        }
+        lines.push_back(line);
+    }
+    return !lines.empty();
+}
+
+bool
+ReadBatch::fill(RecordReader &recordReader, ReadFilter &readFilter) {
+    BamRecord record{};
+    const string unplaced{"*"};
+    auto offset = recordReader.tell();
+    for (; recordStarts.size() < CAPACITY && recordReader.nextRecord(record);
+         offset = recordReader.tell()) {
+        if (!readFilter.passesFlags(record.getFlag()) ||
+            record.getChrIndex() > 1000) {
+            continue;
+        }
+        if (readFilter.filtersPositions()) {
+            auto refId = record.getRefId();
+            const auto &contig =
+                refId < 0 ? unplaced : recordReader.getReferenceNames()[refId];
+            if (!readFilter.passesPosition(contig, record.getPos())) {
+                continue;
+            }
+        }
+        // the reader reuses its buffer for the next record
+        recordStarts.push_back(static_cast<int>(recordData.size()));
+        recordData.insert(recordData.end(), record.getData(),
+                          record.getData() + record.getLength());
+        recordChrIndices.push_back(record.getChrIndex());
+        recordMateChrIndices.push_back(record.getMateChrIndex());
+        recordOffsets.push_back(offset);
+    }
+    return !recordStarts.empty();
+}
+
+void
+ReadBatch::classify() {
+    auto lineBlock = lineBlocks.begin();
+    for (auto line : lines) {
+        while (line.data() < (*lineBlock)->data() ||
+               line.data() >= (*lineBlock)->data() + (*lineBlock)->size()) {
+            ++lineBlock;
+        }
+        classifyLine(line, *lineBlock);
+    }
+    BamRecord record{};
+    for (auto i = 0u; i < recordStarts.size(); ++i) {
+        auto end = i + 1 < recordStarts.size()
+                       ? recordStarts[i + 1]
+                       : static_cast<int>(recordData.size());
+        record.assign(recordData.data() + recordStarts[i],
+                      end - recordStarts[i]);
+        record.setChrIndices(recordChrIndices[i], recordMateChrIndices[i]);
+        classifyRecord(record);
+    }
+}
+
+void
+ReadBatch::classifyLine(string_view line,
+                        const shared_ptr<const vector<char>> &lineBlock) {
+    // QNAME to QUAL, the optional tags are only looked at for the SA tag
+    fieldTabs.clear();
+    SamTokenizer::findTabs(line.data(), 0, static_cast<int>(line.size()),
+                           CompactAlignment::FIELDTABS, fieldTabs);
+    CompactAlignment read{line, fieldTabs};
+    if (read.getChrIndex() > 1000) {
+        return;
+    }
+    // reads without clips or indels have no breakpoints and never support
+    // one, they only count towards coverage and the mate pools
+    if (!read.isEventCandidate()) {
+        read.classifyPlainRead(readParameters.isizeMax);
+        reads.push_back(ClassifiedRead{read, nullptr});
+        return;
+    }
+    auto alignment = takeFreeAlignment();
+    alignment->assign(read, line, lineBlock, fieldTabs);
+    alignment->continueConstruction(readParameters.isizeMax);
+    reads.push_back(ClassifiedRead{read, move(alignment)});
+}
+
+void
+ReadBatch::classifyRecord(const BamRecord &record) {
+    CompactAlignment read{record};
+    if (!read.isEventCandidate()) {
+        read.classifyPlainRead(readParameters.isizeMax);
+        reads.push_back(ClassifiedRead{read, nullptr});
+        return;
+    }
+    auto alignment = takeFreeAlignment();
+    alignment->assign(read, record);
+    alignment->continueConstruction(readParameters.isizeMax);
+    reads.push_back(ClassifiedRead{read, move(alignment)});
+}
+
+void
+ReadBatch::release() {
+    lines.clear();
+    lineBlocks.clear();
+    recordData.clear();
+    recordStarts.clear();
+    recordChrIndices.clear();
+    recordMateChrIndices.clear();
+    recordOffsets.clear();
+    reads.clear();
+}
+
+bool
+ReadBatch::passesFilter(string_view line, ReadFilter &readFilter) {
+    // QNAME, FLAG, RNAME and POS, a malformed line is left to the parser
+    size_t fieldStarts[4]{0, 0, 0, 0};
+    for (auto field = 1; field < 4; ++field) {
+        auto tab = line.find('\t', fieldStarts[field - 1]);
+        if (tab == string_view::npos) {
+            return true;
+        }
+        fieldStarts[field] = tab + 1;
+    }
+    auto readNumber = [&line](size_t start) {
+        auto value = 0;
+        for (auto i = start; i < line.size() && isdigit(line[i]); ++i) {
+            value = 10 * value + (line[i] - '0');
+        }
+        return value;
+    };
+    if (!readFilter.passesFlags(readNumber(fieldStarts[1]))) {
+        return false;
+    }
+    if (!readFilter.filtersPositions()) {
+        return true;
+    }
+    auto contig =
+        line.substr(fieldStarts[2], fieldStarts[3] - 1 - fieldStarts[2]);
+    return readFilter.passesPosition(contig, readNumber(fieldStarts[3]) - 1);
+}
+
+shared_ptr<Alignment>
+ReadBatch::takeFreeAlignment() {
+    // the entries are handed out in turn, so the one at the cursor is the
+    // longest unused and most likely free
+    auto scans = min(alignmentPool.size(), static_cast<size_t>(POOLSCANLIMIT));
+    for (auto i = 0u; i < scans; ++i) {
+        const auto &candidate = alignmentPool[alignmentPoolCursor];
+        alignmentPoolCursor = (alignmentPoolCursor + 1) % alignmentPool.size();
+        if (candidate.use_count() == 1) {
+            // the last reference may have been dropped by the consumer thread
+            atomic_thread_fence(memory_order_acquire);
+            return candidate;
+        }
+    }
+    alignmentPool.push_back(make_shared<Alignment>());
+    return alignmentPool.back();
+}
+
+} /* namespace sophia */
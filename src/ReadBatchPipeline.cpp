@@ -0,0 +1,161 @@
+/*
+ * ReadBatchPipeline.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "ReadBatchPipeline.h"
+#include <algorithm>
+
+namespace sophia {
+
+using namespace std;
+
+ReadBatchPipeline::ReadBatchPipeline(
+    const vector<BatchFiller> &fillersIn,
+    const vector<const ReadParameters *> &readParametersIn, int threadsIn)
+    : THREADS{max(1, threadsIn)}, inputs(fillersIn.size()), classifyQueue{},
+      shuttingDown{false}, threadPool{} {
+    // one batch is held by the consumer, the rest may be queued or classifying
+    auto poolSize = THREADS > 1 ? 4 * THREADS + 1 : 1;
+    for (auto i = 0u; i < inputs.size(); ++i) {
+        inputs[i].fill = fillersIn[i];
+        for (auto j = 0; j < poolSize; ++j) {
+            inputs[i].batchPool.push_back(
+                make_unique<BatchSlot>(*readParametersIn[i]));
+            inputs[i].freeBatches.push_back(inputs[i].batchPool.back().get());
+        }
+    }
+    if (THREADS > 1) {
+        for (auto &input : inputs) {
+            threadPool.emplace_back(&ReadBatchPipeline::readerLoop, this,
+                                    ref(input));
+        }
+        for (auto i = 0; i < THREADS; ++i) {
+            threadPool.emplace_back(&ReadBatchPipeline::workerLoop, this);
+        }
+    }
+}
+
+ReadBatchPipeline::~ReadBatchPipeline() {
+    {
+        lock_guard<mutex> lock{queueMutex};
+        shuttingDown = true;
+    }
+    slotAvailable.notify_all();
+    workAvailable.notify_all();
+    for (auto &worker : threadPool) {
+        worker.join();
+    }
+}
+
+const ReadBatch *
+ReadBatchPipeline::next(int index) {
+    auto &input = inputs[index];
+    if (input.currentBatch != nullptr) {
+        input.currentBatch->batch.release();
+    }
+    if (THREADS == 1) {
+        input.currentBatch = input.batchPool.front().get();
+        if (input.endOfInput || !input.fill(input.currentBatch->batch)) {
+            input.endOfInput = true;
+            return nullptr;
+        }
+        input.currentBatch->batch.classify();
+        return &input.currentBatch->batch;
+    }
+    unique_lock<mutex> lock{queueMutex};
+    if (input.currentBatch != nullptr) {
+        input.freeBatches.push_back(input.currentBatch);
+        input.currentBatch = nullptr;
+        slotAvailable.notify_all();
+    }
+    batchReady.wait(lock, [&input] {
+        return (!input.pendingBatches.empty() &&
+                input.pendingBatches.front()->ready) ||
+               (input.pendingBatches.empty() && input.endOfInput);
+    });
+    if (input.pendingBatches.empty()) {
+        return nullptr;
+    }
+    input.currentBatch = input.pendingBatches.front();
+    input.pendingBatches.pop_front();
+    return &input.currentBatch->batch;
+}
+
+void
+ReadBatchPipeline::readerLoop(Input &input) {
+    while (true) {
+        BatchSlot *slot{nullptr};
+        {
+            unique_lock<mutex> lock{queueMutex};
+            slotAvailable.wait(lock, [this, &input] {
+                return !input.freeBatches.empty() || shuttingDown;
+            });
+            if (shuttingDown) {
+                return;
+            }
+            slot = input.freeBatches.back();
+            input.freeBatches.pop_back();
+        }
+        slot->ready = false;
+        auto filled = input.fill(slot->batch);
+        {
+            lock_guard<mutex> lock{queueMutex};
+            if (!filled) {
+                input.freeBatches.push_back(slot);
+                input.endOfInput = true;
+            } else {
+                input.pendingBatches.push_back(slot);
+                classifyQueue.push_back(slot);
+            }
+        }
+        if (!filled) {
+            batchReady.notify_all();
+            return;
+        }
+        workAvailable.notify_one();
+    }
+}
+
+void
+ReadBatchPipeline::workerLoop() {
+    while (true) {
+        BatchSlot *slot{nullptr};
+        {
+            unique_lock<mutex> lock{queueMutex};
+            workAvailable.wait(lock, [this] {
+                return !classifyQueue.empty() || shuttingDown;
+            });
+            if (shuttingDown) {
+                return;
+            }
+            slot = classifyQueue.front();
+            classifyQueue.pop_front();
+        }
+        slot->batch.classify();
+        {
+            lock_guard<mutex> lock{queueMutex};
+            slot->ready = true;
+        }
+        batchReady.notify_all();
+    }
+}
+
+} /* namespace sophia */
@@ -0,0 +1,127 @@
+/*
+ * ReadCalibrator.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "ReadCalibrator.h"
+#include "SamTokenizer.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace sophia {
+
+using namespace std;
+
+ReadCalibrator::ReadCalibrator(int pairCountIn)
+    : PAIRCOUNT{max(MINPAIRCOUNT, pairCountIn)}, READLIMIT{10 * PAIRCOUNT},
+      readCount{0}, isizes{}, readLengthCounts{}, readLength{0},
+      medianIsize{0.0}, isizeStd{0.0} {}
+
+void
+ReadCalibrator::calibrate(SamLineReader &lineReader) {
+    // QNAME FLAG RNAME POS MAPQ CIGAR RNEXT PNEXT TLEN SEQ QUAL
+    const auto tabCount = 10;
+    auto parseInt = [](string_view field) {
+        auto negative = !field.empty() && field[0] == '-';
+        auto value = 0;
+        for (auto i = negative ? 1u : 0u; i < field.size(); ++i) {
+            value = 10 * value + (field[i] - '0');
+        }
+        return negative ? -value : value;
+    };
+    vector<int> tabs;
+    string_view line;
+    lineReader.mark();
+    while (lineReader.nextLine(line)) {
+        tabs.clear();
+        if (line.empty() || line[0] == '@' ||
+            SamTokenizer::findTabs(line.data(), 0,
+                                   static_cast<int>(line.size()), tabCount,
+                                   tabs) < tabCount) {
+            continue;
+        }
+        auto flag = parseInt(line.substr(tabs[0] + 1, tabs[1] - tabs[0] - 1));
+        auto templateLength =
+            parseInt(line.substr(tabs[7] + 1, tabs[8] - tabs[7] - 1));
+        auto sequenceLength = tabs[9] - tabs[8] - 1;
+        if (line[tabs[8] + 1] == '*') {
+            sequenceLength = 0;
+        }
+        if (!addRead(flag, templateLength, sequenceLength)) {
+            break;
+        }
+    }
+    lineReader.rewind();
+    estimate();
+}
+
+void
+ReadCalibrator::calibrate(ReplayRecordReader &recordReader) {
+    BamRecord record;
+    recordReader.mark();
+    while (recordReader.nextRecord(record)) {
+        if (!addRead(record.getFlag(), record.getTemplateLength(),
+                     record.getSequenceLength())) {
+            break;
+        }
+    }
+    recordReader.rewind();
+    estimate();
+}
+
+bool
+ReadCalibrator::addRead(int flag, int templateLength, int sequenceLength) {
+    ++readCount;
+    // neither secondary nor supplementary
+    if ((flag & 0x900) == 0 && sequenceLength > 0) {
+        if (sequenceLength >= static_cast<int>(readLengthCounts.size())) {
+            readLengthCounts.resize(sequenceLength + 1);
+        }
+        ++readLengthCounts[sequenceLength];
+    }
+    // one insert size per proper pair, from its first read, if both reads
+    // are mapped and neither is a duplicate, a qc failure or not primary
+    if ((flag & 0x43) == 0x43 && (flag & 0xf0c) == 0 && templateLength != 0) {
+        isizes.push_back(abs(templateLength));
+    }
+    return static_cast<int>(isizes.size()) < PAIRCOUNT &&
+           readCount < READLIMIT;
+}
+
+void
+ReadCalibrator::estimate() {
+    readLength = static_cast<int>(
+        max_element(readLengthCounts.begin(), readLengthCounts.end()) -
+        readLengthCounts.begin());
+    if (!hasIsizes()) {
+        return;
+    }
+    auto middle = isizes.begin() + isizes.size() / 2;
+    nth_element(isizes.begin(), middle, isizes.end());
+    auto median = *middle;
+    for (auto &isize : isizes) {
+        isize = abs(isize - median);
+    }
+    nth_element(isizes.begin(), middle, isizes.end());
+    medianIsize = median;
+    isizeStd = 1.4826 * *middle;
+}
+
+} /* namespace sophia */
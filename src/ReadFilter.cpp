@@ -0,0 +1,140 @@
+/*
+ * ReadFilter.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "ReadFilter.h"
+#include "BedReader.h"
+#include <algorithm>
+#include <climits>
+#include <sstream>
+
+namespace sophia {
+
+using namespace std;
+
+ReadFilter::ReadFilter()
+    : requiredFlags{0}, excludedFlags{0}, includeOnly{false}, contigs{},
+      contigIndices{}, unlisted{"", false, {}, {}}, lastContig{},
+      lastContigIndex{-1} {}
+
+void
+ReadFilter::setFlags(int requiredFlagsIn, int excludedFlagsIn) {
+    requiredFlags = requiredFlagsIn;
+    excludedFlags = excludedFlagsIn;
+}
+
+void
+ReadFilter::excludeContigs(const string &contigList) {
+    istringstream contigStream{contigList};
+    string contig;
+    while (getline(contigStream, contig, ',')) {
+        if (!contig.empty()) {
+            addContig(contig).excluded = true;
+        }
+    }
+}
+
+void
+ReadFilter::addRegions(const string &bedFileName, bool include) {
+    BedReader bedReader{bedFileName};
+    string contig;
+    int start{0}, end{0};
+    while (bedReader.nextInterval(contig, start, end)) {
+        auto &regions = addContig(contig);
+        auto &intervals = include ? regions.includes : regions.excludes;
+        intervals.emplace_back(start, end);
+    }
+    includeOnly = includeOnly || include;
+    for (auto &regions : contigs) {
+        mergeIntervals(regions.includes);
+        mergeIntervals(regions.excludes);
+    }
+}
+
+ReadFilter::ContigRegions &
+ReadFilter::addContig(const string &name) {
+    auto it = contigIndices.find(name);
+    if (it != contigIndices.end()) {
+        return contigs[it->second];
+    }
+    contigIndices.emplace(name, static_cast<int>(contigs.size()));
+    contigs.push_back(ContigRegions{name, false, {}, {}});
+    lastContig.clear();
+    lastContigIndex = -1;
+    return contigs.back();
+}
+
+void
+ReadFilter::mergeIntervals(vector<pair<int, int>> &intervals) {
+    sort(intervals.begin(), intervals.end());
+    vector<pair<int, int>> merged;
+    for (const auto &interval : intervals) {
+        if (!merged.empty() && interval.first <= merged.back().second) {
+            merged.back().second = max(merged.back().second, interval.second);
+        } else {
+            merged.push_back(interval);
+        }
+    }
+    intervals = move(merged);
+}
+
+const ReadFilter::ContigRegions &
+ReadFilter::lookUp(string_view contig) {
+    // sorted input asks for the same contig over and over
+    if (lastContig != contig) {
+        lastContig = contig;
+        auto it = contigIndices.find(lastContig);
+        lastContigIndex = it == contigIndices.end() ? -1 : it->second;
+    }
+    return lastContigIndex < 0 ? unlisted : contigs[lastContigIndex];
+}
+
+int
+ReadFilter::nextPassingPosition(string_view contig, int pos) {
+    const auto &regions = lookUp(contig);
+    if (regions.excluded) {
+        return INT_MAX;
+    }
+    auto endsBy = [](const pair<int, int> &interval, int position) {
+        return interval.second <= position;
+    };
+    while (true) {
+        auto next = pos;
+        if (includeOnly) {
+            auto include = lower_bound(regions.includes.begin(),
+                                       regions.includes.end(), next, endsBy);
+            if (include == regions.includes.end()) {
+                return INT_MAX;
+            }
+            next = max(next, include->first);
+        }
+        auto exclude = lower_bound(regions.excludes.begin(),
+                                   regions.excludes.end(), next, endsBy);
+        if (exclude != regions.excludes.end() && exclude->first <= next) {
+            next = exclude->second;
+        }
+        if (next == pos) {
+            return pos;
+        }
+        pos = next;
+    }
+}
+
+} /* namespace sophia */
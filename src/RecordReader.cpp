@@ -0,0 +1,47 @@
+/*
+ * RecordReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "RecordReader.h"
+#include "ChrConverter.h"
+
+namespace sophia {
+
+using namespace std;
+
+void
+RecordReader::addReference(const string &name) {
+    referenceNames.push_back(name);
+    // same conversion as for the RNAME column of the SAM input
+    auto terminated = name + '\t';
+    referenceChrIndices.push_back(
+        ChrConverter::readChromosomeIndex(terminated.cbegin(), '\t'));
+}
+
+int
+RecordReader::toChrIndex(int refId) const {
+    // unmapped references behave like '*' in SAM
+    if (refId < 0 || refId >= static_cast<int>(referenceChrIndices.size())) {
+        return 1003;
+    }
+    return referenceChrIndices[refId];
+}
+
+} /* namespace sophia */
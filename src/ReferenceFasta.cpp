@@ -0,0 +1,151 @@
+/*
+ * ReferenceFasta.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "ReferenceFasta.h"
+#include "HelperFunctions.h"
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace sophia {
+
+using namespace std;
+
+ReferenceFasta::ReferenceFasta(const string &fileNameIn)
+    : fileName{fileNameIn}, index{}, cacheMutex{}, cache{} {
+    if (!readIndex()) {
+        buildIndex();
+    }
+}
+
+bool
+ReferenceFasta::readIndex() {
+    ifstream indexFile{fileName + ".fai"};
+    if (!indexFile) {
+        return false;
+    }
+    string line;
+    while (error_terminating_getline(indexFile, line)) {
+        istringstream fields{line};
+        string name;
+        IndexEntry entry{};
+        if (getline(fields, name, '\t') && fields >> entry.length >>
+                                                   entry.offset >>
+                                                   entry.lineBases >>
+                                                   entry.lineWidth) {
+            index.emplace(name, entry);
+        }
+    }
+    return true;
+}
+
+void
+ReferenceFasta::buildIndex() {
+    ifstream fastaFile{fileName};
+    if (!fastaFile) {
+        perror(("Error opening " + fileName).c_str());
+        exit(EXITCODE_IOERROR);
+    }
+    string line;
+    string name;
+    IndexEntry entry{};
+    long position{0};
+    while (error_terminating_getline(fastaFile, line)) {
+        auto lineWidth = static_cast<long>(line.size()) + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty() && line[0] == '>') {
+            if (!name.empty()) {
+                index.emplace(name, entry);
+            }
+            name = line.substr(1, line.find_first_of(" \t") - 1);
+            entry = IndexEntry{0, position + lineWidth, 0, 0};
+        } else if (!name.empty()) {
+            if (entry.lineBases == 0) {
+                entry.lineBases = static_cast<long>(line.size());
+                entry.lineWidth = lineWidth;
+            }
+            entry.length += static_cast<long>(line.size());
+        }
+        position += lineWidth;
+    }
+    if (!name.empty()) {
+        index.emplace(name, entry);
+    }
+}
+
+shared_ptr<const string>
+ReferenceFasta::getSequence(const string &name) {
+    lock_guard<mutex> lock{cacheMutex};
+    for (const auto &cached : cache) {
+        if (cached.first == name) {
+            return cached.second;
+        }
+    }
+    auto entry = index.find(name);
+    if (entry == index.end()) {
+        cerr << "Reference sequence " << name << " not found in " << fileName
+             << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    if (static_cast<int>(cache.size()) == CACHEDSEQUENCES) {
+        cache.erase(cache.begin());
+    }
+    cache.emplace_back(name, loadSequence(entry->second));
+    return cache.back().second;
+}
+
+shared_ptr<const string>
+ReferenceFasta::loadSequence(const IndexEntry &entry) {
+    auto sequence = make_shared<string>();
+    if (entry.length == 0) {
+        return sequence;
+    }
+    auto fileHandle = fopen(fileName.c_str(), "rb");
+    if (fileHandle == nullptr) {
+        perror(("Error opening " + fileName).c_str());
+        exit(EXITCODE_IOERROR);
+    }
+    auto lastLine = (entry.length - 1) / entry.lineBases;
+    auto spanLength =
+        lastLine * entry.lineWidth + entry.length - lastLine * entry.lineBases;
+    string raw(spanLength, '\0');
+    if (fseek(fileHandle, entry.offset, SEEK_SET) != 0 ||
+        fread(&raw[0], 1, spanLength, fileHandle) !=
+            static_cast<size_t>(spanLength)) {
+        cerr << "Truncated reference file " << fileName << endl;
+        exit(EXITCODE_IOERROR);
+    }
+    fclose(fileHandle);
+    sequence->reserve(entry.length);
+    for (auto base : raw) {
+        if (base != '\n' && base != '\r') {
+            sequence->push_back(
+                static_cast<char>(toupper(static_cast<unsigned char>(base))));
+        }
+    }
+    return sequence;
+}
+
+} /* namespace sophia */
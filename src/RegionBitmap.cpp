@@ -0,0 +1,60 @@
+/*
+ * RegionBitmap.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "RegionBitmap.h"
+#include "BedReader.h"
+#include "ChrConverter.h"
+
+namespace sophia {
+
+using namespace std;
+
+void
+RegionBitmap::add(int chrIndex, int startPos, int endPos) {
+    if (chrIndex >= static_cast<int>(bins.size())) {
+        bins.resize(chrIndex + 1);
+    }
+    auto &chrBins = bins[chrIndex];
+    auto lastBin = endPos / BINSIZE;
+    if (lastBin >= static_cast<int>(chrBins.size())) {
+        chrBins.resize(lastBin + 1, false);
+    }
+    for (auto bin = startPos / BINSIZE; bin <= lastBin; ++bin) {
+        chrBins[bin] = true;
+    }
+}
+
+void
+RegionBitmap::addBed(const string &bedFileName) {
+    BedReader bedReader{bedFileName};
+    string contig;
+    int start{0}, end{0};
+    while (bedReader.nextInterval(contig, start, end)) {
+        if (end > start) {
+            contig.push_back('\t');
+            add(ChrConverter::readChromosomeIndex(contig.cbegin(), '\t'),
+                start + 1, end);
+        }
+    }
+}
+
+} /* namespace sophia */
@@ -0,0 +1,94 @@
+/*
+ * ReplayRecordReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "ReplayRecordReader.h"
+
+namespace sophia {
+
+using namespace std;
+
+ReplayRecordReader::ReplayRecordReader(RecordReader &inputIn)
+    : input{inputIn}, marked{false}, replayed{0}, recordData{},
+      recordStarts{}, recordChrIndices{}, recordMateChrIndices{},
+      recordOffsets{} {
+    for (const auto &name : input.getReferenceNames()) {
+        addReference(name);
+    }
+}
+
+bool
+ReplayRecordReader::nextRecord(BamRecord &record) {
+    if (!marked && replayed < recordStarts.size()) {
+        auto start = recordStarts[replayed];
+        auto end = replayed + 1 < recordStarts.size()
+                       ? recordStarts[replayed + 1]
+                       : recordData.size();
+        record.assign(recordData.data() + start, static_cast<int>(end - start));
+        record.setChrIndices(recordChrIndices[replayed],
+                             recordMateChrIndices[replayed]);
+        ++replayed;
+        return true;
+    }
+    if (!marked && !recordStarts.empty()) {
+        // the last copy handed out is no longer needed
+        vector<char>{}.swap(recordData);
+        vector<size_t>{}.swap(recordStarts);
+        vector<int>{}.swap(recordChrIndices);
+        vector<int>{}.swap(recordMateChrIndices);
+        vector<uint64_t>{}.swap(recordOffsets);
+        replayed = 0;
+    }
+    auto offset = marked ? input.tell() : NOOFFSET;
+    if (!input.nextRecord(record)) {
+        return false;
+    }
+    if (marked) {
+        recordOffsets.push_back(offset);
+        recordStarts.push_back(recordData.size());
+        recordData.insert(recordData.end(), record.getData(),
+                          record.getData() + record.getLength());
+        recordChrIndices.push_back(record.getChrIndex());
+        recordMateChrIndices.push_back(record.getMateChrIndex());
+    }
+    return true;
+}
+
+uint64_t
+ReplayRecordReader::tell() const {
+    if (!marked && replayed < recordOffsets.size()) {
+        return recordOffsets[replayed];
+    }
+    return input.tell();
+}
+
+void
+ReplayRecordReader::mark() {
+    marked = true;
+}
+
+void
+ReplayRecordReader::rewind() {
+    marked = false;
+    replayed = 0;
+}
+
+} /* namespace sophia */
@@ -0,0 +1,109 @@
+/*
+ * SaTag.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "SaTag.h"
+#include "ChrConverter.h"
+#include <cctype>
+
+namespace sophia {
+
+using namespace std;
+
+void
+SaTag::decode(string_view value, vector<SaEntry> &entries) {
+    //"SA:Z:10,24753146,+,68S33M,48,1;X,135742083,-,47S22M32S,0,0;"
+    entries.clear();
+    if (value.empty()) {
+        return;
+    }
+    auto it = value.cbegin();
+    const auto end = value.cend();
+    while (true) {
+        SaEntry entry{};
+        entry.chrIndex = ChrConverter::readChromosomeIndex(it, ',');
+        while (*it != ',') {
+            ++it;
+        }
+        for (++it; *it != ','; ++it) {
+            entry.pos = 10 * entry.pos + (*it - '0');
+        }
+        ++it;
+        entry.strand = *it;
+        it += 2;
+        // the offset of the first largest S or H chunk, positions on the read
+        // do not count a leading soft clip and are shifted by indels
+        auto encounteredM = false;
+        auto count = 0, cumulativeCount = 0, indelAdjustment = 0,
+             leftClipAdjustment = 0, largestClip = 0;
+        for (; *it != ','; ++it) {
+            if (isdigit(*it)) {
+                count = 10 * count + (*it - '0');
+                continue;
+            }
+            switch (*it) {
+            case 'M':
+                encounteredM = true;
+                cumulativeCount += count;
+                break;
+            case 'S':
+            case 'H':
+                if (*it == 'S' && !encounteredM) {
+                    leftClipAdjustment = count;
+                }
+                if (largestClip < count) {
+                    largestClip = count;
+                    entry.clipOffset =
+                        encounteredM ? cumulativeCount + indelAdjustment -
+                                           leftClipAdjustment
+                                     : 0;
+                }
+                if (*it == 'S') {
+                    cumulativeCount += count;
+                }
+                break;
+            case 'I':
+                indelAdjustment -= count;
+                cumulativeCount += count;
+                break;
+            case 'D':
+                indelAdjustment += count;
+                break;
+            default:
+                break;
+            }
+            count = 0;
+        }
+        for (++it; it != end && isdigit(*it); ++it) {
+            entry.mapq = 10 * entry.mapq + (*it - '0');
+        }
+        entries.push_back(entry);
+        while (it != end && *it != ';') {
+            ++it;
+        }
+        if (it == end) {
+            return;
+        }
+        ++it;
+    }
+}
+
+} /* namespace sophia */
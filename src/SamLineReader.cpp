@@ -0,0 +1,124 @@
+/*
+ * SamLineReader.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "SamLineReader.h"
+#include "HelperFunctions.h"
+#include <atomic>
+#include <cstring>
+
+namespace sophia {
+
+using namespace std;
+
+SamLineReader::SamLineReader(FILE *inputIn)
+    : input{inputIn}, block{make_shared<vector<char>>(BLOCKSIZE)},
+      spareBlocks{}, cursor{0}, filled{0}, markedCursor{0}, marked{false},
+      endOfInput{false} {}
+
+bool
+SamLineReader::nextLine(string_view &line) {
+    while (true) {
+        auto lineStart = block->data() + cursor;
+        auto lineEnd = static_cast<const char *>(
+            memchr(lineStart, '\n', filled - cursor));
+        if (lineEnd != nullptr) {
+            line = string_view{lineStart,
+                               static_cast<size_t>(lineEnd - lineStart)};
+            cursor += line.size() + 1;
+            return true;
+        }
+        if (endOfInput) {
+            // the last line may lack its newline
+            if (cursor == filled) {
+                return false;
+            }
+            line = string_view{lineStart, filled - cursor};
+            cursor = filled;
+            return true;
+        }
+        refill();
+    }
+}
+
+void
+SamLineReader::mark() {
+    markedCursor = cursor;
+    marked = true;
+}
+
+void
+SamLineReader::rewind() {
+    cursor = markedCursor;
+    marked = false;
+}
+
+void
+SamLineReader::refill() {
+    // the incomplete last line, and all lines since mark, move to the front of
+    // the next block, which is the current one if no alignment holds on to it
+    auto keepFrom = marked ? markedCursor : cursor;
+    auto carry = filled - keepFrom;
+    if (block.use_count() == 1) {
+        // the last other reference may have been dropped by another thread
+        atomic_thread_fence(memory_order_acquire);
+        memmove(block->data(), block->data() + keepFrom, carry);
+    } else {
+        auto nextBlock = takeFreeBlock();
+        if (nextBlock->size() < block->size()) {
+            nextBlock->resize(block->size());
+        }
+        memcpy(nextBlock->data(), block->data() + keepFrom, carry);
+        spareBlocks.push_back(move(block));
+        block = move(nextBlock);
+    }
+    cursor -= keepFrom;
+    markedCursor = 0;
+    filled = carry;
+    if (filled == block->size()) {
+        // a single line longer than a block
+        block->resize(2 * block->size());
+    }
+    auto bytesRead = fread(block->data() + filled, 1, block->size() - filled,
+                           input);
+    if (bytesRead == 0) {
+        if (ferror(input)) {
+            perror("Error reading SAM input");
+            exit(EXITCODE_IOERROR);
+        }
+        endOfInput = true;
+    }
+    filled += bytesRead;
+}
+
+shared_ptr<vector<char>>
+SamLineReader::takeFreeBlock() {
+    for (auto it = spareBlocks.begin(); it != spareBlocks.end(); ++it) {
+        if (it->use_count() == 1) {
+            atomic_thread_fence(memory_order_acquire);
+            auto freeBlock = move(*it);
+            spareBlocks.erase(it);
+            return freeBlock;
+        }
+    }
+    return make_shared<vector<char>>(BLOCKSIZE);
+}
+
+} /* namespace sophia */
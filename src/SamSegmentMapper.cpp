@@ -23,6 +23,8 @@
  */
 
 #include "SamSegmentMapper.h"
+#include "SamTokenizer.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -32,114 +34,205 @@ namespace sophia {
 
 using namespace std;
 
-SamSegmentMapper::SamSegmentMapper(int defaultReadLengthIn)
-    : STARTTIME{time(nullptr)},
+namespace {
+
+RegionBitmap
+hg19MateBlacklist() {
+    RegionBitmap blacklist{};
+    blacklist.add(2, 33140000, 33149999);
+    return blacklist;
+}
+
+} // namespace
+
+RegionBitmap SamSegmentMapper::MATEBLACKLIST = hg19MateBlacklist();
+
+SamSegmentMapper::SamSegmentMapper(const ReadParameters &readParametersIn,
+                                   int threadsIn,
+                                   BreakpointOutput &outputIn,
+                                   DepthTrack *depthTrackIn,
+                                   WindowBudget *windowBudgetIn,
+                                   Checkpoint *checkpointIn)
+    : STARTTIME{time(nullptr)}, THREADS{max(1, threadsIn)}, output{outputIn},
+      depthTrack{depthTrackIn}, windowBudget{windowBudgetIn},
+      checkpoint{checkpointIn}, readParameters{readParametersIn},
       PROPERPARIRCOMPENSATIONMODE{Breakpoint::PROPERPAIRCOMPENSATIONMODE},
-      DISCORDANTLEFTRANGE{static_cast<int>(round(defaultReadLengthIn * 3))},
-      DISCORDANTRIGHTRANGE{static_cast<int>(round(defaultReadLengthIn * 2.51))},
-      printedBps{0u}, chrIndexCurrent{0}, minPos{-1}, maxPos{-1},
-      breakpointsCurrent{}, discordantAlignmentsPool{},
-      discordantAlignmentCandidatesPool{}, discordantLowQualAlignmentsPool{} {}
+      DISCORDANTLEFTRANGE{
+          static_cast<int>(round(readParameters.defaultReadLength * 3))},
+      DISCORDANTRIGHTRANGE{
+          static_cast<int>(round(readParameters.defaultReadLength * 2.51))},
+      printedBps{0u}, chrIndexCurrent{0}, coverageFrontier{-1},
+      breakpointsCurrent{DISCORDANTLEFTRANGE + DISCORDANTRIGHTRANGE},
+      retainedAlignments{0}, samplingEvidence{false},
+      coverageProfiles{DISCORDANTLEFTRANGE + DISCORDANTRIGHTRANGE},
+      discordantAlignmentsPool{}, discordantAlignmentCandidatesPool{},
+      discordantLowQualAlignmentsPool{}, finalizer{THREADS, outputIn} {}
 
 void
-SamSegmentMapper::parseSamStream() {
-    while (true) {
-        auto alignment = make_shared<Alignment>();
-        if (alignment->getChrIndex() > 1000) {
-            continue;
-        }
-        if (alignment->isValidLine()) {
-            if (alignment->getChrIndex() != chrIndexCurrent) {
-                switchChromosome(*alignment);
-            }
-            alignment->continueConstruction();
-            printBps(alignment->getStartPos());
-            incrementCoverages(*alignment);
-            assignBps(alignment);
-        } else {
-            break;
-        }
+SamSegmentMapper::parseSamStream(SamLineReader &lineReader,
+                                 ReadFilter &readFilter) {
+    parseBatches([&lineReader, &readFilter](ReadBatch &batch) {
+        return batch.fill(lineReader, readFilter);
+    });
+}
+
+void
+SamSegmentMapper::parseRecordStream(RecordReader &recordReader,
+                                    ReadFilter &readFilter) {
+    parseBatches([&recordReader, &readFilter](ReadBatch &batch) {
+        return batch.fill(recordReader, readFilter);
+    });
+}
+
+void
+SamSegmentMapper::parseBatches(const ReadBatchPipeline::BatchFiller &fill) {
+    ReadBatchPipeline pipeline{{fill}, {&readParameters}, THREADS};
+    while (auto batch = pipeline.next(0)) {
+        consumeBatch(*batch);
     }
+    finish();
+}
+
+void
+SamSegmentMapper::finish() {
     // EOF event for the samtools pipe. printing the end of the very last
     // chromosome,
     printBps(numeric_limits<int>::max());
+    printedBps += finalizer.drain();
+    if (windowBudget != nullptr) {
+        windowBudget->endRegion();
+    }
+    if (checkpoint != nullptr) {
+        output.sync();
+        checkpoint->saveFinished(chrIndexCurrent, output.getIndexCount(),
+                                 output.getWrittenBytes());
+    }
 }
 
 void
-SamSegmentMapper::switchChromosome(const Alignment &alignment) {
+SamSegmentMapper::consumeBatch(const ReadBatch &batch) {
+    const auto &reads = batch.getReads();
+    for (auto i = 0u; i < reads.size(); ++i) {
+        const auto &read = reads[i].read;
+        if (read.getChrIndex() != chrIndexCurrent) {
+            auto lastChrIndex = chrIndexCurrent;
+            switchChromosome(read.getChrIndex());
+            if (checkpoint != nullptr && lastChrIndex != 0) {
+                saveCheckpoint(lastChrIndex, batch.getInputOffset(i));
+            }
+        }
+        const auto &alignment = reads[i].alignment;
+        if (!alignment) {
+            printBps(read.getStartPos());
+            checkWindowBudget(read.getStartPos());
+            incrementCoverages(read, {});
+            continue;
+        }
+        printBps(alignment->getStartPos());
+        checkWindowBudget(alignment->getStartPos());
+        incrementCoverages(*alignment, alignment->getReadBreakpoints());
+        incrementBreakpointCoverages(*alignment);
+        assignBps(alignment);
+    }
+}
+
+void
+SamSegmentMapper::switchChromosome(int chrIndex) {
     // As we entered a new chromosome here, now print the previous chromosome's
     // unprinted regions
     if (chrIndexCurrent != 0) {
         printBps(numeric_limits<int>::max());
     }
-    chrIndexCurrent = alignment.getChrIndex();
+    if (windowBudget != nullptr) {
+        windowBudget->endRegion();
+    }
+    chrIndexCurrent = chrIndex;
     breakpointsCurrent.clear();
+    retainedAlignments = 0;
     coverageProfiles.clear();
     discordantAlignmentsPool.clear();
     if (PROPERPARIRCOMPENSATIONMODE) {
         discordantAlignmentCandidatesPool.clear();
     }
     discordantLowQualAlignmentsPool.clear();
-    minPos = -1;
-    maxPos = -1;
+    coverageFrontier = -1;
+}
+
+void
+SamSegmentMapper::saveCheckpoint(int lastChrIndex, uint64_t inputOffset) {
+    // a run resuming here starts with the state of a fresh run, as
+    // switchChromosome emptied the window and the reports are all written
+    printedBps += finalizer.drain();
+    output.sync();
+    checkpoint->save(lastChrIndex, inputOffset, output.getIndexCount(),
+                     output.getWrittenBytes());
 }
 
 void
 SamSegmentMapper::printBps(int alignmentStart) {
-    for (auto &bp : breakpointsCurrent) {
-        if (!bp.second.isCovFinalized() && ((bp.first) + 1 < alignmentStart)) {
-            auto posDiff = bp.first - minPos;
-            if (bp.first != minPos) {
-                bp.second.setLeftCoverage(
-                    coverageProfiles[bp.first - minPos - 1].getCoverage());
-            } else {
-                bp.second.setLeftCoverage(0);
-            }
-            bp.second.setRightCoverage(coverageProfiles[posDiff].getCoverage());
-            bp.second.setNormalSpans(
-                coverageProfiles[posDiff].getNormalSpans());
-            bp.second.setLowQualSpansSoft(
-                coverageProfiles[posDiff].getLowQualSpansSoft());
-            bp.second.setLowQualSpansHard(
-                coverageProfiles[posDiff].getLowQualSpansHard());
-            bp.second.setUnpairedBreaksSoft(
-                coverageProfiles[posDiff].getNormalBpsSoft());
-            bp.second.setUnpairedBreaksHard(
-                coverageProfiles[posDiff].getNormalBpsHard());
-            bp.second.setBreaksShortIndel(
-                coverageProfiles[posDiff].getNormalBpsShortIndel());
-            bp.second.setLowQualBreaksSoft(
-                coverageProfiles[posDiff].getLowQualBpsSoft());
-            bp.second.setLowQualBreaksHard(
-                coverageProfiles[posDiff].getLowQualBpsHard());
-            bp.second.setCovFinalized(true);
+    // the coverages of breakpoints left of the frontier are final already, and
+    // new breakpoints are never placed left of it since the alignments arrive
+    // sorted, so every breakpoint is visited here once
+    auto summed = false;
+    auto finalizeCoverages = [&](int pos, Breakpoint &bp) {
+        if (!summed) {
+            coverageProfiles.sumUpTo(alignmentStart - 2);
+            summed = true;
         }
-    }
-    if (minPos != -1) {
-        while (minPos + 2 + DISCORDANTLEFTRANGE < alignmentStart) {
-            if (minPos != maxPos) {
-                coverageProfiles.pop_front();
-                ++minPos;
-            } else {
-                coverageProfiles.clear();
-                minPos = -1;
-                maxPos = -1;
-                break;
+        if (pos != coverageProfiles.getMinPos()) {
+            bp.setLeftCoverage(coverageProfiles.getCoverage(pos - 1));
+        } else {
+            bp.setLeftCoverage(0);
+        }
+        bp.setRightCoverage(coverageProfiles.getCoverage(pos));
+        bp.setNormalSpans(coverageProfiles.getNormalSpans(pos));
+        bp.setLowQualSpansSoft(coverageProfiles.getLowQualSpansSoft(pos));
+        bp.setLowQualSpansHard(coverageProfiles.getLowQualSpansHard(pos));
+        bp.setUnpairedBreaksSoft(coverageProfiles.getNormalBpsSoft(pos));
+        bp.setUnpairedBreaksHard(coverageProfiles.getNormalBpsHard(pos));
+        bp.setBreaksShortIndel(coverageProfiles.getNormalBpsShortIndel(pos));
+        bp.setLowQualBreaksSoft(coverageProfiles.getLowQualBpsSoft(pos));
+        bp.setLowQualBreaksHard(coverageProfiles.getLowQualBpsHard(pos));
+        bp.setCovFinalized(true);
+    };
+#ifdef SOPHIA_COVERAGE_FULL_SCAN
+    // the scan over every open breakpoint the frontier replaced, only built
+    // for the baseline of CoverageFrontierBenchmark
+    breakpointsCurrent.forEachIn(
+        numeric_limits<int>::min(), numeric_limits<int>::max(),
+        [&](int pos, Breakpoint &bp) {
+            if (!bp.isCovFinalized() && pos + 1 < alignmentStart) {
+                finalizeCoverages(pos, bp);
             }
+        });
+#else
+    if (coverageFrontier < alignmentStart - 1) {
+        breakpointsCurrent.forEachIn(coverageFrontier, alignmentStart - 2,
+                                     finalizeCoverages);
+        coverageFrontier = alignmentStart - 1;
+    }
+#endif
+    if (!coverageProfiles.isEmpty()) {
+        auto dropPos = alignmentStart - 2 - DISCORDANTLEFTRANGE;
+        if (depthTrack != nullptr) {
+            trackDepth(dropPos);
         }
+        coverageProfiles.dropBefore(dropPos);
     }
-    for (auto bpIt = breakpointsCurrent.begin();
-         bpIt != breakpointsCurrent.end();) {
-        if ((bpIt->first) + DISCORDANTRIGHTRANGE < alignmentStart) {
-            if (bpIt->second.finalizeBreakpoint(
-                    discordantAlignmentsPool, discordantLowQualAlignmentsPool,
-                    discordantAlignmentCandidatesPool)) {
-                ++printedBps;
-            }
-            bpIt = breakpointsCurrent.erase(bpIt);
-        } else {
-            break;
+    while (!breakpointsCurrent.isEmpty() &&
+           breakpointsCurrent.getFirstPos() + DISCORDANTRIGHTRANGE <
+               alignmentStart) {
+        auto &breakpoint = breakpointsCurrent.getFirst();
+        retainedAlignments -= breakpoint.getRetainedAlignments();
+        if (breakpoint.prepareFinalization(discordantAlignmentsPool,
+                                           discordantLowQualAlignmentsPool,
+                                           discordantAlignmentCandidatesPool,
+                                           output)) {
+            printedBps += finalizer.submit(breakpoint,
+                                           discordantAlignmentsPool,
+                                           discordantLowQualAlignmentsPool);
         }
+        breakpointsCurrent.popFirst();
     }
     while (!discordantAlignmentsPool.empty() &&
            (discordantAlignmentsPool.front().readStartPos +
@@ -164,30 +257,46 @@ SamSegmentMapper::printBps(int alignmentStart) {
 }
 
 void
-SamSegmentMapper::incrementCoverages(const Alignment &alignment) {
-    if (minPos == -1) {
-        for (auto i = alignment.getStartPos(); i < alignment.getEndPos(); ++i) {
-            coverageProfiles.emplace_back();
-        }
-        minPos = alignment.getStartPos();
-        maxPos = alignment.getEndPos() - 1;
+SamSegmentMapper::trackDepth(int pos) {
+    auto endPos = min(pos, coverageProfiles.getMaxPos() + 1);
+    if (coverageProfiles.getMinPos() < endPos) {
+        coverageProfiles.sumUpTo(endPos - 1);
+        depthTrack->add(chrIndexCurrent, coverageProfiles,
+                        coverageProfiles.getMinPos(), endPos);
+    }
+}
+
+void
+SamSegmentMapper::checkWindowBudget(int pos) {
+    if (windowBudget == nullptr) {
+        return;
+    }
+    windowBudget->update(chrIndexCurrent, pos, retainedAlignments,
+                         discordantAlignmentsPool.size() +
+                             discordantAlignmentCandidatesPool.size() +
+                             discordantLowQualAlignmentsPool.size());
+    auto samplingLevel = windowBudget->getSamplingLevel();
+    samplingEvidence = samplingLevel > 0;
+    discordantAlignmentsPool.setSamplingLevel(samplingLevel);
+    discordantAlignmentCandidatesPool.setSamplingLevel(samplingLevel);
+    discordantLowQualAlignmentsPool.setSamplingLevel(samplingLevel);
+}
+
+void
+SamSegmentMapper::incrementCoverages(const CompactAlignment &alignment,
+                                     const vector<int> &readBreakpoints) {
+    if (coverageProfiles.isEmpty()) {
+        coverageProfiles.start(alignment.getStartPos(),
+                               alignment.getEndPos() - 1);
     } else {
-        while (alignment.getStartPos() > maxPos) {
-            coverageProfiles.emplace_back();
-            ++maxPos;
-        }
+        coverageProfiles.extendTo(alignment.getStartPos());
     }
     switch (alignment.getReadType()) {
     case 0:
     case 3:
-        for (auto i = alignment.getStartPos(); i < alignment.getEndPos(); ++i) {
-            if (i > maxPos) {
-                coverageProfiles.emplace_back();
-                ++maxPos;
-            }
-            coverageProfiles[i - minPos].incrementCoverage();
-            coverageProfiles[i - minPos].incrementNormalSpans();
-        }
+        coverageProfiles.extendTo(alignment.getEndPos() - 1);
+        coverageProfiles.addNormalSpans(alignment.getStartPos(),
+                                        alignment.getEndPos());
         if (PROPERPARIRCOMPENSATIONMODE) {
             discordantAlignmentCandidatesPool.emplace_back(
                 alignment.getStartPos(), alignment.getEndPos(), -1, -1, -1,
@@ -195,27 +304,17 @@ SamSegmentMapper::incrementCoverages(const Alignment &alignment) {
         }
         break;
     case 1:
-        for (auto i = alignment.getStartPos(); i < alignment.getEndPos(); ++i) {
-            if (i > maxPos) {
-                coverageProfiles.emplace_back();
-                ++maxPos;
-            }
-            coverageProfiles[i - minPos].incrementCoverage();
-            coverageProfiles[i - minPos].incrementNormalSpans();
-        }
+        coverageProfiles.extendTo(alignment.getEndPos() - 1);
+        coverageProfiles.addNormalSpans(alignment.getStartPos(),
+                                        alignment.getEndPos());
         break;
     case 4:
-        for (auto i = alignment.getStartPos(); i < alignment.getEndPos(); ++i) {
-            if (i > maxPos) {
-                coverageProfiles.emplace_back();
-                ++maxPos;
-            }
-            coverageProfiles[i - minPos].incrementCoverage();
-            coverageProfiles[i - minPos].incrementNormalSpans();
-        }
+        coverageProfiles.extendTo(alignment.getEndPos() - 1);
+        coverageProfiles.addNormalSpans(alignment.getStartPos(),
+                                        alignment.getEndPos());
         if (alignment.getMateChrIndex() < 1002 &&
-            !(alignment.getMateChrIndex() == 2 &&
-              (alignment.getMatePos() / 10000 == 3314))) {
+            !MATEBLACKLIST.contains(alignment.getMateChrIndex(),
+                                    alignment.getMatePos())) {
             if (PROPERPARIRCOMPENSATIONMODE) {
                 discordantAlignmentCandidatesPool.emplace_back(
                     alignment.getStartPos(), alignment.getEndPos(),
@@ -236,71 +335,53 @@ SamSegmentMapper::incrementCoverages(const Alignment &alignment) {
         }
         break;
     case 2:
-        if (!(alignment.isLowMapq() || alignment.isNullMapq())) {
-            for (auto i = alignment.getStartPos(); i < alignment.getEndPos();
-                 ++i) {
-                if (i > maxPos) {
-                    coverageProfiles.emplace_back();
-                    ++maxPos;
-                }
-            }
-        } else {
-            for (auto i = alignment.getStartPos(); i < alignment.getEndPos();
-                 ++i) {
-                if (i > maxPos) {
-                    coverageProfiles.emplace_back();
-                    ++maxPos;
-                }
-                coverageProfiles[i - minPos].incrementLowQualSpansHard();
-            }
+        coverageProfiles.extendTo(alignment.getEndPos() - 1);
+        if (alignment.isLowMapq() || alignment.isNullMapq()) {
+            coverageProfiles.addLowQualSpansHard(alignment.getStartPos(),
+                                                 alignment.getEndPos());
         }
         break;
     case 5:
-        for (auto i = alignment.getStartPos(); i < alignment.getEndPos(); ++i) {
-            if (i > maxPos) {
-                coverageProfiles.emplace_back();
-                ++maxPos;
-            }
-            coverageProfiles[i - minPos].incrementLowQualSpansSoft();
-        }
+        coverageProfiles.extendTo(alignment.getEndPos() - 1);
+        coverageProfiles.addLowQualSpansSoft(alignment.getStartPos(),
+                                             alignment.getEndPos());
         if (!alignment.isSupplementary() &&
             alignment.getMateChrIndex() < 1002 && alignment.isDistantMate()) {
-            if (!(alignment.getMateChrIndex() == 2 &&
-                  (alignment.getMatePos() / 10000 == 3314))) {
+            if (!MATEBLACKLIST.contains(alignment.getMateChrIndex(),
+                                        alignment.getMatePos())) {
                 discordantLowQualAlignmentsPool.emplace_back(
                     alignment.getStartPos(), alignment.getEndPos(),
                     alignment.getMateChrIndex(), alignment.getMatePos(), 2,
-                    alignment.isInvertedMate(), alignment.getReadBreakpoints());
+                    alignment.isInvertedMate(), readBreakpoints);
             }
         }
         break;
     default:
         break;
     }
+}
+
+void
+SamSegmentMapper::incrementBreakpointCoverages(const Alignment &alignment) {
     switch (alignment.getReadType()) {
     case 1:
         for (auto j = 0u; j < alignment.getReadBreakpoints().size(); ++j) {
             auto bpPos = alignment.getReadBreakpoints()[j];
-            if (bpPos > maxPos) {
-                coverageProfiles.emplace_back();
-                ++maxPos;
-            }
+            coverageProfiles.extendTo(bpPos);
             switch (alignment.getReadBreakpointTypes()[j]) {
             case 'S':
                 if (bpPos == alignment.getStartPos()) {
-                    coverageProfiles[bpPos - minPos].decrementNormalSpans();
+                    coverageProfiles.decrementNormalSpans(bpPos);
                 }
-                coverageProfiles[bpPos - minPos].incrementNormalBpsSoft();
+                coverageProfiles.incrementNormalBpsSoft(bpPos);
                 break;
             case 'I':
-                coverageProfiles[bpPos - minPos].incrementNormalBpsShortIndel();
+                coverageProfiles.incrementNormalBpsShortIndel(bpPos);
                 break;
             case 'D':
-                coverageProfiles[bpPos - minPos].incrementNormalBpsShortIndel();
-                for (auto k = 0; k != alignment.getReadBreakpointsSizes()[j];
-                     ++k) {
-                    coverageProfiles[bpPos - minPos + k].decrementNormalSpans();
-                }
+                coverageProfiles.incrementNormalBpsShortIndel(bpPos);
+                coverageProfiles.removeNormalSpans(
+                    bpPos, bpPos + alignment.getReadBreakpointsSizes()[j]);
                 break;
             default:
                 break;
@@ -310,20 +391,15 @@ SamSegmentMapper::incrementCoverages(const Alignment &alignment) {
     case 3:
         for (auto j = 0u; j < alignment.getReadBreakpoints().size(); ++j) {
             auto bpPos = alignment.getReadBreakpoints()[j];
-            if (bpPos > maxPos) {
-                coverageProfiles.emplace_back();
-                ++maxPos;
-            }
+            coverageProfiles.extendTo(bpPos);
             switch (alignment.getReadBreakpointTypes()[j]) {
             case 'I':
-                coverageProfiles[bpPos - minPos].incrementNormalBpsShortIndel();
+                coverageProfiles.incrementNormalBpsShortIndel(bpPos);
                 break;
             case 'D':
-                coverageProfiles[bpPos - minPos].incrementNormalBpsShortIndel();
-                for (auto k = 0; k != alignment.getReadBreakpointsSizes()[j];
-                     ++k) {
-                    coverageProfiles[bpPos - minPos + k].decrementNormalSpans();
-                }
+                coverageProfiles.incrementNormalBpsShortIndel(bpPos);
+                coverageProfiles.removeNormalSpans(
+                    bpPos, bpPos + alignment.getReadBreakpointsSizes()[j]);
                 break;
             default:
                 break;
@@ -334,46 +410,35 @@ SamSegmentMapper::incrementCoverages(const Alignment &alignment) {
         if (!(alignment.isLowMapq() || alignment.isNullMapq())) {
             for (auto j = 0u; j < alignment.getReadBreakpoints().size(); ++j) {
                 auto bpPos = alignment.getReadBreakpoints()[j];
-                if (bpPos > maxPos) {
-                    coverageProfiles.emplace_back();
-                    ++maxPos;
-                }
+                coverageProfiles.extendTo(bpPos);
                 if (alignment.getReadBreakpointTypes()[j] == 'H') {
-                    coverageProfiles[bpPos - minPos].incrementNormalBpsHard();
+                    coverageProfiles.incrementNormalBpsHard(bpPos);
                 }
             }
         } else {
             for (auto j = 0u; j < alignment.getReadBreakpoints().size(); ++j) {
                 auto bpPos = alignment.getReadBreakpoints()[j];
-                if (bpPos > maxPos) {
-                    coverageProfiles.emplace_back();
-                    ++maxPos;
-                }
+                coverageProfiles.extendTo(bpPos);
                 switch (alignment.getReadBreakpointTypes()[j]) {
                 case 'S':
                     if (bpPos == alignment.getStartPos()) {
-                        coverageProfiles[bpPos - minPos]
-                            .decrementLowQualSpansHard();
+                        coverageProfiles.decrementLowQualSpansHard(bpPos);
                     }
-                    coverageProfiles[bpPos - minPos].incrementLowQualBpsHard();
+                    coverageProfiles.incrementLowQualBpsHard(bpPos);
                     break;
                 case 'H':
                     if (bpPos == alignment.getStartPos()) {
-                        coverageProfiles[bpPos - minPos]
-                            .decrementLowQualSpansHard();
+                        coverageProfiles.decrementLowQualSpansHard(bpPos);
                     }
-                    coverageProfiles[bpPos - minPos].incrementLowQualBpsHard();
+                    coverageProfiles.incrementLowQualBpsHard(bpPos);
                     break;
                 case 'I':
-                    coverageProfiles[bpPos - minPos].incrementLowQualBpsHard();
+                    coverageProfiles.incrementLowQualBpsHard(bpPos);
                     break;
                 case 'D':
-                    coverageProfiles[bpPos - minPos].incrementLowQualBpsHard();
-                    for (auto k = 0;
-                         k != alignment.getReadBreakpointsSizes()[j]; ++k) {
-                        coverageProfiles[bpPos - minPos + k]
-                            .decrementLowQualSpansHard();
-                    }
+                    coverageProfiles.incrementLowQualBpsHard(bpPos);
+                    coverageProfiles.removeLowQualSpansHard(
+                        bpPos, bpPos + alignment.getReadBreakpointsSizes()[j]);
                     break;
                 default:
                     break;
@@ -384,29 +449,22 @@ SamSegmentMapper::incrementCoverages(const Alignment &alignment) {
     case 5:
         for (auto j = 0u; j < alignment.getReadBreakpoints().size(); ++j) {
             auto bpPos = alignment.getReadBreakpoints()[j];
-            if (bpPos > maxPos) {
-                coverageProfiles.emplace_back();
-                ++maxPos;
-            }
+            coverageProfiles.extendTo(bpPos);
             switch (alignment.getReadBreakpointTypes()[j]) {
             case 'S':
             case 'H':
                 if (bpPos == alignment.getStartPos()) {
-                    coverageProfiles[bpPos - minPos]
-                        .decrementLowQualSpansSoft();
+                    coverageProfiles.decrementLowQualSpansSoft(bpPos);
                 }
-                coverageProfiles[bpPos - minPos].incrementLowQualBpsSoft();
+                coverageProfiles.incrementLowQualBpsSoft(bpPos);
                 break;
             case 'I':
-                coverageProfiles[bpPos - minPos].incrementLowQualBpsSoft();
+                coverageProfiles.incrementLowQualBpsSoft(bpPos);
                 break;
             case 'D':
-                coverageProfiles[bpPos - minPos].incrementLowQualBpsSoft();
-                for (auto k = 0; k != alignment.getReadBreakpointsSizes()[j];
-                     ++k) {
-                    coverageProfiles[bpPos - minPos + k]
-                        .decrementLowQualSpansSoft();
-                }
+                coverageProfiles.incrementLowQualBpsSoft(bpPos);
+                coverageProfiles.removeLowQualSpansSoft(
+                    bpPos, bpPos + alignment.getReadBreakpointsSizes()[j]);
                 break;
             default:
                 break;
@@ -419,37 +477,29 @@ SamSegmentMapper::incrementCoverages(const Alignment &alignment) {
 }
 
 void
-SamSegmentMapper::assignBps(shared_ptr<Alignment> &alignment) {
+SamSegmentMapper::assignBps(const shared_ptr<Alignment> &alignment) {
     switch (alignment->getReadType()) {
     case 1:
         for (auto i = 0u; i < alignment->getReadBreakpoints().size(); ++i) {
             if (alignment->getReadBreakpointTypes()[i] == 'S') {
-                auto bpLoc = alignment->getReadBreakpoints()[i];
-                auto it = breakpointsCurrent.find(bpLoc);
-                if (it == breakpointsCurrent.end()) {
-                    auto newIt = breakpointsCurrent.emplace(
-                        piecewise_construct, forward_as_tuple(bpLoc),
-                        forward_as_tuple(chrIndexCurrent, bpLoc));
-                    newIt.first->second.addSoftAlignment(alignment);
-                } else {
-                    it->second.addSoftAlignment(alignment);
-                }
+                retainedAlignments +=
+                    breakpointsCurrent
+                        .findOrAdd(chrIndexCurrent,
+                                   alignment->getReadBreakpoints()[i],
+                                   readParameters)
+                        .addSoftAlignment(alignment, samplingEvidence);
             }
         }
         break;
     case 2:
         for (auto i = 0u; i < alignment->getReadBreakpoints().size(); ++i) {
             if (alignment->getReadBreakpointTypes()[i] == 'H') {
-                auto bpLoc = alignment->getReadBreakpoints()[i];
-                auto it = breakpointsCurrent.find(bpLoc);
-                if (it == breakpointsCurrent.end()) {
-                    auto newIt = breakpointsCurrent.emplace(
-                        piecewise_construct, forward_as_tuple(bpLoc),
-                        forward_as_tuple(chrIndexCurrent, bpLoc));
-                    newIt.first->second.addHardAlignment(alignment);
-                } else {
-                    it->second.addHardAlignment(alignment);
-                }
+                retainedAlignments +=
+                    breakpointsCurrent
+                        .findOrAdd(chrIndexCurrent,
+                                   alignment->getReadBreakpoints()[i],
+                                   readParameters)
+                        .addHardAlignment(alignment, samplingEvidence);
             }
         }
         break;
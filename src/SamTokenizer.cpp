@@ -0,0 +1,126 @@
+/*
+ * SamTokenizer.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+#include "SamTokenizer.h"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace sophia {
+
+using namespace std;
+
+namespace {
+
+int
+findTabsScalar(const char *line, int from, int length, int maxTabs,
+               vector<int> &positions) {
+    auto found = 0;
+    for (auto i = from; i < length && found < maxTabs; ++i) {
+        if (line[i] == '\t') {
+            positions.push_back(i);
+            ++found;
+        }
+    }
+    return found;
+}
+
+#if defined(__x86_64__)
+// appends the set bits of a comparison mask as positions, false once
+// maxTabs positions are found
+inline bool
+appendMask(unsigned int mask, int offset, int maxTabs, int &found,
+           vector<int> &positions) {
+    while (mask != 0) {
+        positions.push_back(offset + __builtin_ctz(mask));
+        if (++found == maxTabs) {
+            return false;
+        }
+        mask &= mask - 1;
+    }
+    return true;
+}
+
+int
+findTabsSse2(const char *line, int from, int length, int maxTabs,
+             vector<int> &positions) {
+    auto found = 0;
+    if (maxTabs <= 0) {
+        return found;
+    }
+    const auto tabs = _mm_set1_epi8('\t');
+    auto i = from;
+    for (; i + 16 <= length; i += 16) {
+        auto chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(line + i));
+        auto mask = static_cast<unsigned int>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, tabs)));
+        if (!appendMask(mask, i, maxTabs, found, positions)) {
+            return found;
+        }
+    }
+    return found +
+           findTabsScalar(line, i, length, maxTabs - found, positions);
+}
+
+__attribute__((target("avx2"))) int
+findTabsAvx2(const char *line, int from, int length, int maxTabs,
+             vector<int> &positions) {
+    auto found = 0;
+    if (maxTabs <= 0) {
+        return found;
+    }
+    const auto tabs = _mm256_set1_epi8('\t');
+    auto i = from;
+    for (; i + 32 <= length; i += 32) {
+        auto chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(line + i));
+        auto mask = static_cast<unsigned int>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, tabs)));
+        if (!appendMask(mask, i, maxTabs, found, positions)) {
+            return found;
+        }
+    }
+    return found + findTabsSse2(line, i, length, maxTabs - found, positions);
+}
+
+#endif
+
+} // namespace
+
+vector<SamTokenizer::Scanner>
+SamTokenizer::getSupportedScanners() {
+    vector<Scanner> scanners;
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        scanners.push_back(Scanner{"AVX2", findTabsAvx2});
+    }
+    scanners.push_back(Scanner{"SSE2", findTabsSse2});
+#endif
+    scanners.push_back(Scanner{"scalar", findTabsScalar});
+    return scanners;
+}
+
+const SamTokenizer::TabScanner SamTokenizer::SCANNER =
+    SamTokenizer::getSupportedScanners().front().scan;
+
+} /* namespace sophia */
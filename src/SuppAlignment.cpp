@@ -31,16 +31,15 @@ namespace sophia {
 
     using namespace std;
 
-double SuppAlignment::ISIZEMAX { };
-
 int SuppAlignment::DEFAULTREADLENGTH { };
 
-SuppAlignment::SuppAlignment(string::const_iterator saCbegin, string::const_iterator saCend, bool primaryIn, bool lowMapqSourceIn, bool nullMapqSourceIn, bool alignmentOnForwardStrand, bool bpEncounteredM, int originIndexIn, int bpChrIndex, int bpPos) :
-				matchFuzziness { 5 * DEFAULTREADLENGTH },
-				chrIndex { 0 },
-				pos { 0 },
+SuppAlignment::SuppAlignment(const SaEntry &saEntry, bool primaryIn, bool lowMapqSourceIn, bool nullMapqSourceIn, bool alignmentOnForwardStrand, bool bpEncounteredM, int originIndexIn, int bpChrIndex, int bpPos, const ReadParameters &readParameters) :
+				defaultReadLength { readParameters.defaultReadLength },
+				matchFuzziness { 5 * defaultReadLength },
+				chrIndex { saEntry.chrIndex },
+				pos { saEntry.pos + saEntry.clipOffset },
 				extendedPos { 0 },
-				mapq { 0 },
+				mapq { saEntry.mapq },
 				supportingIndices { },
 				supportingIndicesSecondary { },
 				distinctReads { 1 },
@@ -65,90 +64,13 @@ SuppAlignment::SuppAlignment(string::const_iterator saCbegin, string::const_iter
 	} else {
 		supportingIndicesSecondary.push_back(originIndexIn);
 	}
-//	//"SA:Z:10,24753146,+,68S33M,48,1;X,135742083,-,47S22M32S,0,0;8,72637925,-,29S19M53S,0,0;"
-//	//"10,24753146,+,68S33M,48,1"
-//	for (auto cigarString_cit = saCbegin; cigarString_cit != saCend; ++cigarString_cit) {
-//		cerr << *cigarString_cit;
-//	}
-//	cerr << endl;
-	vector<string::const_iterator> fieldBegins = { saCbegin };
-	vector<string::const_iterator> fieldEnds;
-	for (auto it = saCbegin; it != saCend; ++it) {
-		if (*it == ',') {
-			fieldEnds.push_back(it);
-			fieldBegins.push_back(it + 1);
-		}
-	}
-	fieldEnds.push_back(saCend);
-	chrIndex = ChrConverter::readChromosomeIndex(fieldBegins[0], ',');
-	if (chrIndex > 1001) {
-		return;
-	}
-	for (auto it = fieldBegins[1]; it != fieldEnds[1]; ++it) {
-		pos = 10 * pos + (*it - '0');
-	}
-//cerr << "guessSupplementOffset" << endl;
-	vector<CigarChunk> cigarChunks;
-	auto cigarEncounteredM = false;
-	auto cumulativeNucleotideCount = 0, currentNucleotideCount = 0, chunkIndex = 0, bestChunkIndex = 0, indelAdjustment = 0;
-	auto largestClip = 0;
-	auto leftClipAdjustment = 0;
-	for (auto cigarString_cit = fieldBegins[3]; cigarString_cit != fieldEnds[3]; ++cigarString_cit) {
-		if (isdigit(*cigarString_cit)) {
-			currentNucleotideCount = currentNucleotideCount * 10 + (*cigarString_cit - '0');
-		} else {
-			switch (*cigarString_cit) {
-			case 'M':
-				cigarEncounteredM = true;
-				cumulativeNucleotideCount += currentNucleotideCount;
-				break;
-			case 'S':
-				if (!cigarEncounteredM) {
-					leftClipAdjustment = currentNucleotideCount;
-				}
-				cigarChunks.emplace_back(*cigarString_cit, cigarEncounteredM, cumulativeNucleotideCount + indelAdjustment - leftClipAdjustment, currentNucleotideCount);
-				if (largestClip < currentNucleotideCount) {
-					largestClip = currentNucleotideCount;
-					bestChunkIndex = chunkIndex;
-				}
-				++chunkIndex;
-				cumulativeNucleotideCount += currentNucleotideCount;
-				break;
-			case 'H':
-				cigarChunks.emplace_back(*cigarString_cit, cigarEncounteredM, cumulativeNucleotideCount + indelAdjustment - leftClipAdjustment, currentNucleotideCount);
-				if (largestClip < currentNucleotideCount) {
-					largestClip = currentNucleotideCount;
-					bestChunkIndex = chunkIndex;
-				}
-				++chunkIndex;
-				break;
-			case 'I':
-				indelAdjustment -= currentNucleotideCount;
-				cumulativeNucleotideCount += currentNucleotideCount;
-				break;
-			case 'D':
-				indelAdjustment += currentNucleotideCount;
-				break;
-			default:
-				break;
-			}
-			currentNucleotideCount = 0;
-		}
-	}
-	if (cigarChunks[bestChunkIndex].encounteredM) {
-		pos += cigarChunks[bestChunkIndex].startPosOnRead;
-	}
 	extendedPos = pos;
-	//cerr << "done" << endl;
-	for (auto it = fieldBegins[4]; it != fieldEnds[4]; ++it) {
-		mapq = 10 * mapq + (*it - '0');
-	}
 	if (alignmentOnForwardStrand) {
-		inverted = ('+' != *fieldBegins[2]);
+		inverted = ('+' != saEntry.strand);
 	} else {
-		inverted = ('-' != *fieldBegins[2]);
+		inverted = ('-' != saEntry.strand);
 	}
-	distant = (bpChrIndex != chrIndex || (abs(bpPos - pos) > ISIZEMAX));
+	distant = (bpChrIndex != chrIndex || (abs(bpPos - pos) > readParameters.isizeMax));
 	if (bpChrIndex == chrIndex) {
 		matchFuzziness = min(abs(bpPos - pos), matchFuzziness);
 	}
@@ -164,8 +86,9 @@ void SuppAlignment::finalizeSupportingIndices() {
 	secondarySupport = static_cast<int>(supportingIndicesSecondary.size());
 }
 
-SuppAlignment::SuppAlignment(int chrIndexIn, int posIn, int mateSupportIn, int expectedDiscordantsIn, bool encounteredMIn, bool invertedIn, int extendedPosIn, bool primaryIn, bool lowMapqSourceIn, bool nullMapqSourceIn, int originIndexIn) :
-				matchFuzziness { 5 * DEFAULTREADLENGTH },
+SuppAlignment::SuppAlignment(int chrIndexIn, int posIn, int mateSupportIn, int expectedDiscordantsIn, bool encounteredMIn, bool invertedIn, int extendedPosIn, bool primaryIn, bool lowMapqSourceIn, bool nullMapqSourceIn, int originIndexIn, const ReadParameters &readParameters) :
+				defaultReadLength { readParameters.defaultReadLength },
+				matchFuzziness { 5 * defaultReadLength },
 				chrIndex { chrIndexIn },
 				pos { posIn },
 				extendedPos { extendedPosIn },
@@ -235,7 +158,8 @@ string SuppAlignment::print() const {
 }
 
 SuppAlignment::SuppAlignment(const string& saIn) :
-				matchFuzziness { 5 * DEFAULTREADLENGTH },
+				defaultReadLength { DEFAULTREADLENGTH },
+				matchFuzziness { 5 * defaultReadLength },
 				chrIndex { 0 },
 				pos { 0 },
 				extendedPos { 0 },
@@ -321,7 +245,7 @@ SuppAlignment::SuppAlignment(const string& saIn) :
 bool SuppAlignment::saCloseness(const SuppAlignment& rhs, int fuzziness) const {
 	if (inverted == rhs.isInverted() && chrIndex == rhs.getChrIndex() && encounteredM == rhs.isEncounteredM()) {
 		if (strictFuzzy || rhs.isStrictFuzzy()) {
-			fuzziness = 2.5 * DEFAULTREADLENGTH;
+			fuzziness = 2.5 * defaultReadLength;
 			return (rhs.getPos() - fuzziness) <= (extendedPos + fuzziness) && (pos - fuzziness) <= (rhs.getExtendedPos() + fuzziness);
 		} else {
 			return abs(pos - rhs.getPos()) <= fuzziness;
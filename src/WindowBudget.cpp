@@ -0,0 +1,98 @@
+/*
+ * WindowBudget.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: DKFZ Heidelberg (Omics IT and Data Management Core Facility)
+ *
+ *     This program is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     This program is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *      LICENSE: GPL
+ */
+
+
+#include "WindowBudget.h"
+#include "ChrConverter.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace sophia {
+
+using namespace std;
+
+WindowBudget::WindowBudget(long budgetBytesIn, ostream *logIn)
+    : BUDGETBYTES{budgetBytesIn}, log{logIn}, samplingLevel{0},
+      levelChangedAt{0}, regionChrIndex{0}, regionStart{0}, regionEnd{0},
+      regionLevel{0}, regionPeakBytes{0} {
+    if (log != nullptr) {
+        // the breakpoints in the regions keep their coverage counts, the
+        // counts taken from the sampled reads and mates are scaled up
+        *log << "# exact: shortIndelReads,normalSpans,lowQualSpansSoft,"
+                "lowQualSpansHard,leftCoverage,rightCoverage; scaled up from "
+                "the samples: mateReadSupport and the split of the clipped "
+                "reads into pairedBreaks,unpairedBreaks,lowQualBreaks and "
+                "repetitiveOverhangs; taken from the samples: suppAlignments,"
+                "significantOverhangs\n"
+             << "#chr\tstart\tend\tpeakWindowMb\tsamplingLevel\n";
+    }
+}
+
+void
+WindowBudget::update(int chrIndex, int pos, long retainedAlignments,
+                     long retainedMates) {
+    auto bytes =
+        retainedAlignments * ALIGNMENTBYTES + retainedMates * MATEBYTES;
+    if (bytes > BUDGETBYTES && samplingLevel < MAXSAMPLINGLEVEL) {
+        if (samplingLevel == 0) {
+            regionChrIndex = chrIndex;
+            regionStart = pos;
+            regionLevel = 0;
+            regionPeakBytes = 0;
+        }
+        ++samplingLevel;
+        levelChangedAt = pos;
+    } else if (samplingLevel > 0 && bytes < BUDGETBYTES / 2 &&
+               pos - levelChangedAt >= LEVELDISTANCE) {
+        --samplingLevel;
+        levelChangedAt = pos;
+        if (samplingLevel == 0) {
+            regionEnd = pos;
+            endRegion();
+            return;
+        }
+    }
+    if (samplingLevel > 0) {
+        regionEnd = pos;
+        regionLevel = max(regionLevel, samplingLevel);
+        regionPeakBytes = max(regionPeakBytes, bytes);
+    }
+}
+
+void
+WindowBudget::endRegion() {
+    if (regionLevel == 0) {
+        return;
+    }
+    if (log != nullptr) {
+        char line[256];
+        snprintf(line, sizeof(line), "%s\t%d\t%d\t%.1f\t%d\n",
+                 ChrConverter::indexToChr[regionChrIndex].c_str(),
+                 regionStart - 1, regionEnd, regionPeakBytes / 1048576.0,
+                 regionLevel);
+        *log << line;
+    }
+    samplingLevel = 0;
+    levelChangedAt = 0;
+    regionLevel = 0;
+}
+
+} /* namespace sophia */